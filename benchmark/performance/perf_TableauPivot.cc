@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <benchmark/benchmark.h>
+#include <lasolver/Tableau.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+// Pivots back and forth on a random tableau, so that every iteration works on the same rows.
+// Arguments: number of rows, number of columns, number of terms in a row, maximal absolute value of a coefficient.
+class TableauPivotFixture : public ::benchmark::Fixture {
+protected:
+    Tableau tableau;
+    std::vector<LVRef> basic;
+    std::vector<LVRef> pivotVars;
+
+public:
+    void SetUp(const ::benchmark::State & st) override {
+        auto rowCount = static_cast<unsigned>(st.range(0));
+        auto colCount = static_cast<unsigned>(st.range(1));
+        auto rowSize = static_cast<unsigned>(st.range(2));
+        auto maxCoeff = static_cast<int>(st.range(3));
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<unsigned> colDist(0, colCount - 1);
+        std::uniform_int_distribution<int> coeffDist(1, maxCoeff);
+        tableau.clear();
+        basic.clear();
+        pivotVars.clear();
+        for (unsigned i = 0; i < colCount; ++i) {
+            tableau.newNonbasicVar(LVRef{i});
+        }
+        for (unsigned i = 0; i < rowCount; ++i) {
+            LVRef rowVar{colCount + i};
+            auto poly = std::make_unique<Polynomial>();
+            for (unsigned j = 0; j < rowSize; ++j) {
+                LVRef var{colDist(rng)};
+                if (poly->contains(var)) { continue; }
+                int coeff = coeffDist(rng);
+                poly->addTerm(var, rng() % 2 ? coeff : -coeff);
+            }
+            tableau.newRow(rowVar, std::move(poly));
+            tableau.quasiToBasic(rowVar);
+            basic.push_back(rowVar);
+            pivotVars.push_back(tableau.getRowPoly(rowVar).begin()->var);
+        }
+    }
+
+    void TearDown(const ::benchmark::State &) override {
+        tableau.clear();
+    }
+};
+
+BENCHMARK_DEFINE_F(TableauPivotFixture, PivotAndBack)(benchmark::State & st) {
+    std::size_t i = 0;
+    for (auto _ : st) {
+        LVRef bv = basic[i];
+        LVRef nv = pivotVars[i];
+        tableau.pivot(bv, nv);
+        tableau.pivot(nv, bv);
+        i = (i + 1) % basic.size();
+    }
+}
+
+BENCHMARK_REGISTER_F(TableauPivotFixture, PivotAndBack)
+    ->Args({100, 100, 5, 1})
+    ->Args({100, 100, 20, 10})
+    ->Args({200, 50, 30, 100})
+    ->Args({50, 200, 100, 1000});
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <benchmark/benchmark.h>
+#include <ArithLogic.h>
+
+#include <string>
+
+// Bulk construction of distinct terms: measures the hash-consing throughput of Logic::insertTerm
+static void BM_BulkTermConstruction(benchmark::State & state) {
+    int const numVars = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        ArithLogic logic{opensmt::Logic_t::QF_UFLRA};
+        SRef sref = logic.getSort_real();
+        SymRef f = logic.declareFun("f", sref, {sref, sref});
+        vec<PTRef> vars;
+        for (int i = 0; i < numVars; i++) {
+            vars.push(logic.mkRealVar(("x" + std::to_string(i)).c_str()));
+        }
+        state.ResumeTiming();
+        for (int i = 0; i < numVars; i++) {
+            for (int j = 0; j < numVars; j++) {
+                PTRef fij = logic.insertTerm(f, {vars[i], vars[j]});
+                benchmark::DoNotOptimize(logic.insertTerm(logic.get_sym_Real_LEQ(), {fij, vars[j]}));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * state.range(0) * state.range(0));
+}
+BENCHMARK(BM_BulkTermConstruction)->Arg(100)->Arg(300)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+// Lookups of existing terms only: every insertTerm call hits the hash-consing table
+static void BM_TermLookup(benchmark::State & state) {
+    int const numVars = static_cast<int>(state.range(0));
+    ArithLogic logic{opensmt::Logic_t::QF_UFLRA};
+    SRef sref = logic.getSort_real();
+    SymRef f = logic.declareFun("f", sref, {sref, sref});
+    vec<PTRef> vars;
+    for (int i = 0; i < numVars; i++) {
+        vars.push(logic.mkRealVar(("x" + std::to_string(i)).c_str()));
+    }
+    for (int i = 0; i < numVars; i++) {
+        for (int j = 0; j < numVars; j++) {
+            logic.insertTerm(f, {vars[i], vars[j]});
+        }
+    }
+    for (auto _ : state) {
+        for (int i = 0; i < numVars; i++) {
+            for (int j = 0; j < numVars; j++) {
+                benchmark::DoNotOptimize(logic.insertTerm(f, {vars[i], vars[j]}));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+BENCHMARK(BM_TermLookup)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
@@ -39,14 +39,18 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "RDLTHandler.h"
 #include "IDLTHandler.h"
 
+#include "ClauseExchange.h"
+#include "CubeQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <thread>
 #include <random>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 
-namespace opensmt { bool stop; }
-
 void
 MainSolver::push()
 {
@@ -377,7 +381,13 @@ sstat MainSolver::solve()
         const PushFrame& frame = pfstore[frames.getFrameReference(i)];
         en_frames.push(frame.getId());
     }
-    status = sstat(ts.solve(en_frames));
+    if (config.threads() > 1 and canSolveInParallel())
+        status = solveInParallel(en_frames);
+    else
+        status = sstat(ts.solve(en_frames));
+
+    if (status == s_Undef and canConquerSplits())
+        status = conquerSplits(en_frames);
 
     if (status == s_True && config.produce_models())
         thandler.computeModel();
@@ -385,6 +395,315 @@ sstat MainSolver::solve()
     return status;
 }
 
+/**
+ * The parallel modes share the logic and the term mapper between the solvers, so they can use
+ * several threads only when neither the search nor the theory solvers create terms or touch other
+ * shared state.
+ */
+bool MainSolver::canShareLogicBetweenThreads() const
+{
+    using Logic_t = opensmt::Logic_t;
+    Logic_t logicType = logic.getLogic();
+    return logicType == Logic_t::QF_UF or logicType == Logic_t::QF_BOOL;
+}
+
+/**
+ * The portfolio mode is offered when the logic can be shared between threads and no proof is
+ * needed.  In the remaining cases the query is solved sequentially.
+ */
+bool MainSolver::canSolveInParallel() const
+{
+    return canShareLogicBetweenThreads() and not config.produceProof() and not config.produce_inter()
+        and not config.sat_pure_lookahead() and not config.sat_lookahead_split() and not config.use_ghost_vars()
+        and config.sat_split_type() == spt_none;
+}
+
+/**
+ * The cubes of the lookahead splitter are conquered in the process if requested, unless a proof is
+ * needed or the search was stopped.
+ */
+bool MainSolver::canConquerSplits() const
+{
+    return config.sat_split_conquer() and config.sat_lookahead_split()
+        and not config.produceProof() and not config.produce_inter()
+        and not smt_solver->splits.empty() and not smt_solver->stop;
+}
+
+/**
+ * Creates a diversified copy of the SAT and theory solvers containing problem, which is in the
+ * format of CoreSMTSolver::exportProblem.  The copy always searches by CDCL, without splitting.
+ */
+std::unique_ptr<MainSolver::PortfolioWorker> MainSolver::createPortfolioWorker(int index, vec<Lit> const & problem)
+{
+    static constexpr int restartFirst[] = {100, 50, 250, 500};
+    auto worker = std::make_unique<PortfolioWorker>();
+    worker->config = std::make_unique<SMTConfig>();
+    SMTConfig & conf = *worker->config;
+    conf.inheritOptions(config);
+
+    const char* msg;
+    int seed = config.getRandomSeed() + 7919 * index;
+    conf.setOption(SMTConfig::o_random_seed, SMTOption(seed != 0 ? seed : 1), msg);
+    conf.setOption(SMTConfig::o_phase_saving, SMTOption((config.sat_pcontains() + index) % 3), msg);
+    conf.setOption(SMTConfig::o_restart_first, SMTOption(restartFirst[index % 4]), msg);
+    conf.setOption(SMTConfig::o_luby_restart, SMTOption((config.sat_use_luby_restart + index) % 2), msg);
+    conf.sat_use_luby_restart = (config.sat_use_luby_restart + index) % 2;
+    conf.setOption(SMTConfig::o_verbosity, SMTOption(0), msg);
+    conf.setOption(SMTConfig::o_sat_lookahead_split, SMTOption(0), msg);
+    conf.setOption(SMTConfig::o_sat_split_type, SMTOption(spts_none), msg);
+
+    worker->theory = createTheory(logic, conf);
+    worker->thandler = std::make_unique<THandler>(*worker->theory, term_mapper);
+    worker->solver = createInnerSolver(conf, *worker->thandler);
+    worker->solver->initialize();
+
+    SimpSMTSolver & solver = *worker->solver;
+    if (smt_solver->nVars() > 0)
+        solver.addVar(smt_solver->nVars() - 1);
+    vec<Lit> clause;
+    opensmt::pair<CRef, CRef> crefs;
+    for (Lit l : problem) {
+        if (l != lit_Undef) {
+            clause.push(l);
+        } else {
+            solver.addOriginalSMTClause(clause, crefs);
+            clause.clear();
+        }
+    }
+    solver.declareVarsToTheories();
+    return worker;
+}
+
+/**
+ * Makes the main solver satisfiable with the model that other found for the same problem under
+ * assumps.  The main solver is run once more with the model as assumptions, so that models and term
+ * values are available from the main solver as usual.
+ */
+sstat MainSolver::adoptModel(vec<Lit> const & assumps, SimpSMTSolver const & other)
+{
+    smt_solver->clearSearch();
+    vec<Lit> guided;
+    assumps.copyTo(guided);
+    for (Var v = 0; v < smt_solver->nVars() and v < other.model.size(); v++) {
+        if (smt_solver->isEliminated(v) or not smt_solver->isDecisionVar(v) or other.model[v] == l_Undef)
+            continue;
+        guided.push(mkLit(v, other.model[v] == l_False));
+    }
+    lbool res = smt_solver->solveCDCL(guided);
+    assert(res == l_True);
+    if (res == l_False and smt_solver->getConflictFrame() > assumps.size()) {
+        // Not expected, but an assumption taken from the model is to blame: search without them
+        smt_solver->restoreOK();
+        res = smt_solver->solveCDCL(assumps);
+    }
+    return sstat(res);
+}
+
+/**
+ * Runs config.threads() solvers on the current CNF and returns the first answer.  The main solver
+ * takes part in the race in the calling thread.  The other solvers receive a copy of the clauses
+ * of the main solver, and all of them exchange their short learnt clauses.
+ *
+ * All terms needed by the theory solvers are created before any thread is started.  If a worker
+ * wins with an unsatisfiable answer the main solver adopts its conflict, and if it wins with a
+ * model the main solver adopts the model.
+ */
+sstat MainSolver::solveInParallel(vec<FrameId> const & en_frames)
+{
+    vec<Lit> assumps;
+    ts.getAssumptions(en_frames, assumps);
+    bool const do_simp = not config.isIncremental();
+    bool const turn_off_simp = config.isIncremental();
+    int const n = config.threads();
+
+    for (Lit l : assumps)
+        smt_solver->addVar(var(l));
+    smt_solver->declareVarsToTheories();
+
+    vec<Lit> problem;
+    smt_solver->exportProblem(problem);
+
+    ClauseExchange exchange(n);
+    std::vector<std::unique_ptr<PortfolioWorker>> workers;
+    for (int i = 1; i < n; i++) {
+        workers.push_back(createPortfolioWorker(i, problem));
+        workers.back()->solver->setClauseExchange(&exchange, i);
+    }
+    smt_solver->setClauseExchange(&exchange, 0);
+
+    std::atomic<int> winner{-1};
+    std::vector<lbool> results(n, l_Undef);
+    std::vector<std::exception_ptr> errors(n);
+    auto race = [&](int id, SimpSMTSolver & solver) {
+        try {
+            results[id] = solver.solve(assumps, do_simp, turn_off_simp);
+        } catch (...) {
+            errors[id] = std::current_exception();
+        }
+        int none = -1;
+        if ((results[id] != l_Undef or errors[id]) and winner.compare_exchange_strong(none, id)) {
+            smt_solver->stop = true;
+            for (auto & worker : workers)
+                worker->solver->stop = true;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < n; i++)
+        threads.emplace_back(race, i, std::ref(*workers[i-1]->solver));
+    race(0, *smt_solver);
+    for (auto & worker : workers)
+        worker->solver->stop = true;
+    for (auto & thread : threads)
+        thread.join();
+    smt_solver->setClauseExchange(nullptr, 0);
+
+    int const w = winner.load();
+    if (w >= 0)
+        smt_solver->stop = false; // Set by the winner, not by the user
+    if (w >= 0 and errors[w])
+        std::rethrow_exception(errors[w]);
+    if (w <= 0)
+        return sstat(results[0]);
+
+    SimpSMTSolver & other = *workers[w-1]->solver;
+    if (results[w] == l_False) {
+        smt_solver->clearSearch();
+        smt_solver->setConflicting(other.getConflictFrame());
+        return s_False;
+    }
+
+    assert(results[w] == l_True);
+    return adoptModel(assumps, other);
+}
+
+/**
+ * The conquer phase of cube-and-conquer.  The cubes found by the lookahead splitter are solved under
+ * assumptions by copies of the SAT and theory solvers, which take the cubes from a work-stealing
+ * queue and exchange their short learnt clauses.  A cube that is not solved within a conflict
+ * budget is split on its most active variable if some worker is idle, and searched with a doubled
+ * budget otherwise.  The first satisfiable cube cancels the remaining ones and the main solver adopts
+ * its model; if all cubes are unsatisfiable, so is the query.
+ *
+ * The workers run in config.threads() threads if the logic can be shared between threads, and
+ * otherwise one worker conquers the cubes in the calling thread.  Returns s_Undef if the splits are
+ * not cubes or the conquer phase was stopped.
+ */
+sstat MainSolver::conquerSplits(vec<FrameId> const & en_frames)
+{
+    static constexpr int64_t initialBudget = 10000; // Conflicts
+    int const n = canShareLogicBetweenThreads() ? config.threads() : 1;
+    CubeQueue queue(n);
+    int next = 0;
+    for (SplitData const & split : smt_solver->splits) {
+        vec<Lit> cube;
+        if (not split.getCube(cube))
+            return s_Undef;
+        queue.push(next++ % n, std::move(cube));
+    }
+
+    vec<Lit> assumps;
+    ts.getAssumptions(en_frames, assumps);
+    smt_solver->clearSearch();
+    for (Lit l : assumps)
+        smt_solver->addVar(var(l));
+    smt_solver->declareVarsToTheories();
+    vec<Lit> problem;
+    smt_solver->exportProblem(problem);
+
+    ClauseExchange exchange(n);
+    std::vector<std::unique_ptr<PortfolioWorker>> workers;
+    for (int i = 0; i < n; i++) {
+        workers.push_back(createPortfolioWorker(i, problem));
+        workers.back()->solver->setClauseExchange(&exchange, i);
+    }
+
+    std::atomic<int> winner{-1};
+    std::atomic<bool> refuted{false}; // Some cube was unsatisfiable regardless of its literals
+    std::vector<int> conflictFrames(n, 0);
+    std::vector<std::exception_ptr> errors(n);
+    auto cancel = [&]() {
+        queue.cancel();
+        for (auto & worker : workers)
+            worker->solver->stop = true;
+    };
+    auto conquer = [&](int id) {
+        SimpSMTSolver & solver = *workers[id]->solver;
+        vec<Lit> cube;
+        vec<Lit> cubeAssumps;
+        try {
+            while (queue.pop(id, cube)) {
+                assumps.copyTo(cubeAssumps);
+                for (Lit l : cube)
+                    cubeAssumps.push(l);
+                lbool res = l_Undef;
+                bool resplit = false;
+                for (int64_t budget = initialBudget; res == l_Undef and not resplit; budget *= 2) {
+                    if (solver.stop or smt_solver->stop or queue.isCancelled())
+                        break;
+                    solver.setConfBudget(budget);
+                    res = solver.solveLimited(cubeAssumps, false, false);
+                    Var v = var_Undef;
+                    if (res == l_Undef and queue.hasIdleWorkers() and (v = solver.pickCubeExtension(cube)) != var_Undef) {
+                        vec<Lit> other;
+                        cube.copyTo(other);
+                        other.push(mkLit(v, true));
+                        cube.push(mkLit(v));
+                        queue.push(id, std::move(other));
+                        queue.push(id, std::move(cube));
+                        resplit = true;
+                    }
+                }
+                int none = -1;
+                if (res == l_True and winner.compare_exchange_strong(none, id)) {
+                    cancel();
+                } else if (res == l_False) {
+                    conflictFrames[id] = std::max(conflictFrames[id], solver.getConflictFrame());
+                    bool onCube = std::any_of(solver.conflict.begin(), solver.conflict.end(), [&cube](Lit l) {
+                        return std::any_of(cube.begin(), cube.end(), [l](Lit c) { return var(c) == var(l); });
+                    });
+                    if (onCube) {
+                        exchange.publish(id, solver.conflict);
+                        solver.restoreOK();
+                    } else {
+                        refuted = true;
+                        cancel();
+                    }
+                } else if (res == l_Undef and not resplit) {
+                    cancel(); // Stopped or out of resources
+                }
+                queue.done();
+            }
+        } catch (...) {
+            errors[id] = std::current_exception();
+            cancel();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < n; i++)
+        threads.emplace_back(conquer, i);
+    conquer(0);
+    for (auto & thread : threads)
+        thread.join();
+
+    for (auto & error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+    int const w = winner.load();
+    if (w >= 0 or refuted or not queue.isCancelled())
+        smt_solver->splits.clear(); // Conquered; the search of the main solver must not split again
+    if (w >= 0)
+        return adoptModel(assumps, *workers[w]->solver);
+    if (refuted or not queue.isCancelled()) {
+        int frame = *std::max_element(conflictFrames.begin(), conflictFrames.end());
+        smt_solver->setConflicting(std::min(frame, static_cast<int>(frames.size()) - 1)); // The frame may be blamed on a cube literal
+        return s_False;
+    }
+    return s_Undef;
+}
+
 std::unique_ptr<SimpSMTSolver> MainSolver::createInnerSolver(SMTConfig & config, THandler & thandler) {
     SimpSMTSolver* solver = nullptr;
     if (config.sat_pure_lookahead())
@@ -411,12 +730,17 @@ std::unique_ptr<Theory> MainSolver::createTheory(Logic & logic, SMTConfig & conf
             break;
         }
         case Logic_t::QF_CUF:
-        case Logic_t::QF_BV:
         {
             BVLogic & bvLogic = dynamic_cast<BVLogic &>(logic);
             theory = new CUFTheory(config, bvLogic);
             break;
         }
+        case Logic_t::QF_BV:
+        {
+            BVLogic & bvLogic = dynamic_cast<BVLogic &>(logic);
+            theory = new BVTheory(config, bvLogic);
+            break;
+        }
         case Logic_t::QF_LRA:
         {
             ArithLogic & lraLogic = dynamic_cast<ArithLogic &>(logic);
@@ -34,6 +34,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "InterpolationContext.h"
 
 #include <memory>
+#include <vector>
 
 
 class Logic;
@@ -152,6 +153,23 @@ class MainSolver
 
     static std::unique_ptr<Theory> createTheory(Logic & logic, SMTConfig & config);
 
+    // Portfolio mode: diversified copies of the SAT and theory solvers race on the same CNF.
+    // In cube-and-conquer mode the same copies solve the cubes of the lookahead splitter.
+    struct PortfolioWorker {
+        std::unique_ptr<SMTConfig>      config;
+        std::unique_ptr<Theory>         theory;
+        std::unique_ptr<THandler>       thandler;
+        std::unique_ptr<SimpSMTSolver>  solver;
+    };
+
+    bool  canShareLogicBetweenThreads() const;
+    bool  canSolveInParallel() const;
+    bool  canConquerSplits() const;
+    std::unique_ptr<PortfolioWorker> createPortfolioWorker(int index, vec<Lit> const & problem);
+    sstat adoptModel(vec<Lit> const & assumps, SimpSMTSolver const & other);
+    sstat solveInParallel(vec<FrameId> const & en_frames);
+    sstat conquerSplits(vec<FrameId> const & en_frames);
+
   public:
 
     MainSolver(Logic& logic, SMTConfig& conf, std::string name)
@@ -31,6 +31,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <cstdio>
 #include <csignal>
 #include <iostream>
+#include <getopt.h>
 
 #ifdef ENABLE_LINE_EDITING
 #if !defined(USE_READLINE)
@@ -88,7 +89,11 @@ int main( int argc, char * argv[] )
 
     SMTConfig c;
     bool pipe = false;
-    while ((opt = getopt(argc, argv, "hdpir:")) != -1) {
+    static const struct option long_options[] = {
+        {"threads", required_argument, nullptr, 't'},
+        {nullptr,   0,                 nullptr, 0}
+    };
+    while ((opt = getopt_long(argc, argv, "hdpir:t:", long_options, nullptr)) != -1) {
         switch (opt) {
 
             case 'h':
@@ -110,8 +115,12 @@ int main( int argc, char * argv[] )
             case 'p':
                 pipe = true;
                 break;
+            case 't':
+                if (!c.setOption(SMTConfig::o_threads, SMTOption(atoi(optarg)), msg))
+                    fprintf(stderr, "Error setting the number of threads: %s\n", msg);
+                break;
             default: /* '?' */
-                fprintf(stderr, "Usage:\n\t%s [-d] [-h] [-r seed] filename [...]\n",
+                fprintf(stderr, "Usage:\n\t%s [-d] [-h] [-r seed] [-t | --threads n] filename [...]\n",
                         argv[0]);
                 return 0;
         }
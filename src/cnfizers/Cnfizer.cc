@@ -79,6 +79,14 @@ lbool
 Cnfizer::solve(vec<FrameId>& en_frames)
 {
     vec<Lit> assumps;
+    getAssumptions(en_frames, assumps);
+    return solver.solve(assumps, !config.isIncremental(), config.isIncremental());
+}
+
+void
+Cnfizer::getAssumptions(vec<FrameId> const & en_frames, vec<Lit> & assumps)
+{
+    assumps.clear();
     // Initialize so that by default frames are disabled
     for (PTRef tr : frame_terms) {
         assumps.push(this->getOrCreateLiteralFor(tr));
@@ -100,8 +108,6 @@ Cnfizer::solve(vec<FrameId>& en_frames)
             assumps[j++] = assumps[i];
     }
     assumps.shrink(i-j);
-    return solver.solve(assumps, !config.isIncremental(), config.isIncremental());
-
 }
 
 void Cnfizer::setFrameTerm(FrameId frame_id)
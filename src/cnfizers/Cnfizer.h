@@ -83,6 +83,7 @@ public:
 
     void   initialize      ();
     lbool  solve           (vec<FrameId>& en_frames);
+    void   getAssumptions  (vec<FrameId> const & en_frames, vec<Lit> & assumps); // The assumption literals solve uses to enable the frames en_frames
 
     bool  solverEmpty      ()                     const { return s_empty; }
 
@@ -8,26 +8,51 @@ Copyright (c) 2008, 2009 Centre national de la recherche scientifique (CNRS)
 #include <sstream>
 #include <algorithm>
 
+namespace {
+struct FreeMpqs {
+    std::vector<mpq_ptr> mpqs;
+    ~FreeMpqs();
+};
+
+thread_local bool freeMpqsDestroyed = false; // Trivially destructible, so it can be read during the thread exit
+thread_local FreeMpqs freeMpqs;
+
+FreeMpqs::~FreeMpqs()
+{
+    for (mpq_ptr ptr : mpqs) {
+        mpq_clear(ptr);
+        delete ptr;
+    }
+    freeMpqsDestroyed = true;
+}
+}
+
 mpq_ptr FastRational::mpqPool::alloc()
 {
-    mpq_ptr r;
-    if (!pool.empty()) {
-        r = pool.top();
-        pool.pop();
-    } else {
-        r = store.emplace().get_mpq_t();
+    if (!freeMpqsDestroyed and !freeMpqs.mpqs.empty()) {
+        mpq_ptr r = freeMpqs.mpqs.back();
+        freeMpqs.mpqs.pop_back();
+        return r;
     }
+    mpq_ptr r = new __mpq_struct;
+    mpq_init(r);
     return r;
 }
 
 void FastRational::mpqPool::release(mpq_ptr ptr)
 {
-    pool.push(ptr);
+    if (freeMpqsDestroyed) {
+        // A static FastRational outlived the pool of the thread
+        mpq_clear(ptr);
+        delete ptr;
+    } else {
+        freeMpqs.mpqs.push_back(ptr);
+    }
 }
 
 FastRational::FastRational( const char * s, const int base )
 {
-    mpq = pool.alloc();
+    mpq = mpqPool::alloc();
     mpq_set_str(mpq, s, base);
     mpq_canonicalize( mpq );
     state = State::MPQ_ALLOCATED_AND_VALID;
@@ -44,7 +69,7 @@ FastRational::FastRational(mpz_t z)
         den = 1;
         state = State::WORD_VALID;
     } else {
-        mpq = pool.alloc();
+        mpq = mpqPool::alloc();
         mpz_set(mpq_numref(mpq), z);
         mpz_set_ui(mpq_denref(mpq), 1);
         state = State::MPQ_ALLOCATED_AND_VALID;
@@ -54,7 +79,7 @@ FastRational::FastRational(mpz_t z)
 FastRational::FastRational(uint32_t x)
 {
     if (x > INT_MAX) {
-        mpq = pool.alloc();
+        mpq = mpqPool::alloc();
         mpq_set_ui(mpq, x, 1);
         state = State::MPQ_ALLOCATED_AND_VALID;
     } else {
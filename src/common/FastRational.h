@@ -11,7 +11,6 @@ Copyright (c) 2008, 2009 Centre national de la recherche scientifique (CNRS)
 #include <cassert>
 #include <climits>
 #include "Vec.h"
-#include <stack>
 #include <vector>
 
 typedef int32_t  word;
@@ -69,22 +68,22 @@ inline ulword absVal(lword x) {
 
 class FastRational
 {
+    // Recycles the mpq_t values of the current thread.  The values are allocated individually so that a
+    // FastRational created in one thread can be destroyed in another one.
     class mpqPool
     {
-        std::stack<mpq_class> store; // uses deque as storage to avoid realloc
-        std::stack<mpq_ptr, std::vector<mpq_ptr>> pool;
     public:
-        mpq_ptr alloc();
-        void release(mpq_ptr);
+        static mpq_ptr alloc();
+        static void release(mpq_ptr);
     };
     State state;
     word num{0};
     uword den{1};
     mpq_ptr mpq{nullptr};
 
-    inline static mpqPool pool;
     inline static thread_local mpz_class temp;
     inline static mpz_ptr mpz() { return temp.get_mpz_t(); }
+    inline static thread_local mpq_class tempProduct;
 
 
     // Bit masks for questioning state:
@@ -148,7 +147,7 @@ private:
     void kill_mpq()
     {
         if (mpqMemoryAllocated()) {
-            pool.release(mpq);
+            mpqPool::release(mpq);
             state = State::WORD_VALID;
         }
     }
@@ -156,7 +155,7 @@ private:
         if (!mpqPartValid()) {
             assert(wordPartValid());
             if (!mpqMemoryAllocated()) {
-                mpq = pool.alloc();
+                mpq = mpqPool::alloc();
             }
             mpz_set_si(mpq_numref(mpq), num);
             mpz_set_ui(mpq_denref(mpq), den);
@@ -170,7 +169,7 @@ private:
     void ensure_mpq_memory_allocated()
     {
         if (!mpqMemoryAllocated()) {
-            mpq = pool.alloc();
+            mpq = mpqPool::alloc();
             setMpqMemoryAllocated();
         }
     }
@@ -199,6 +198,7 @@ private:
     friend inline void multiplication      (FastRational &, const FastRational &, const FastRational &);
     friend inline void division            (FastRational &, const FastRational &, const FastRational &);
     friend inline void additionAssign      (FastRational &, const FastRational &);
+    friend inline void multiplyAddAssign   (FastRational &, const FastRational &, const FastRational &);
     friend inline void substractionAssign  (FastRational &, const FastRational &);
     friend inline void multiplicationAssign(FastRational &, const FastRational &);
     friend inline void divisionAssign      (FastRational &, const FastRational &);
@@ -419,7 +419,7 @@ inline FastRational::FastRational(const FastRational& x) {
     }
     else {
         assert(x.mpqPartValid());
-        mpq = pool.alloc();
+        mpq = mpqPool::alloc();
         mpq_set(mpq, x.mpq);
         state = State::MPQ_ALLOCATED_AND_VALID;
     }
@@ -441,7 +441,7 @@ inline FastRational& FastRational::operator=(const FastRational& x) {
     else {
         assert(x.mpqPartValid());
         if (!this->mpqMemoryAllocated()) {
-            mpq = pool.alloc();
+            mpq = mpqPool::alloc();
         }
         mpq_set(mpq, x.mpq);
         this->state = State::MPQ_ALLOCATED_AND_VALID;
@@ -464,7 +464,7 @@ inline FastRational FastRational::operator-() const {
     } else {
         force_ensure_mpq_valid();
         FastRational x;
-        x.mpq = pool.alloc();
+        x.mpq = mpqPool::alloc();
         mpq_neg(x.mpq, mpq);
         x.state = State::MPQ_ALLOCATED_AND_VALID;
         x.try_fit_word(); // MB: If current value is 2^31, it does not fit word representation, but it's negation -2^31 does.
@@ -907,6 +907,72 @@ inline void additionAssign(FastRational& a, const FastRational& b) {
     a.try_fit_word();
 }
 
+// a += b * c.  The product is kept in double words and only the result has to fit in a word.
+inline void multiplyAddAssign(FastRational& a, const FastRational& b, const FastRational& c) {
+    if (b.wordPartValid() && c.wordPartValid()) {
+        if (b.num == 0 || c.num == 0) return;
+        if (a.wordPartValid()) {
+            // |pn| <= 2^62 and pd < 2^64, neither overflows
+            lword pn;
+            ulword pd;
+            if (b.den == 1 && c.den == 1) {
+                pn = lword(b.num) * c.num;
+                pd = 1;
+            } else {
+                uword common1 = gcd(absVal(b.num), c.den);
+                uword common2 = gcd(b.den, absVal(c.num));
+                pn = (common1 > 1 ? lword(b.num) / common1 : lword(b.num)) * (common2 > 1 ? lword(c.num) / common2 : lword(c.num));
+                pd = ulword(common2 > 1 ? b.den / common2 : b.den) * (common1 > 1 ? c.den / common1 : c.den);
+            }
+            if (pd == 1 && a.den == 1) {
+                CHECK_WORD(a.num, lword(a.num) + pn);
+            } else {
+                word n;
+                uword d;
+                CHECK_WORD(n, pn);
+                CHECK_UWORD(d, pd);
+                if (a.num == 0) {
+                    a.num = n;
+                    a.den = d;
+                } else if (d == 1) {
+                    CHECK_WORD(a.num, lword(a.num) + lword(n)*a.den);
+                } else {
+                    // Knuth, TAOCP 4.5.1: the result only needs to be reduced by a factor of the common denominator
+                    uword d1 = gcd(a.den, d);
+                    lword c1 = lword(a.num) * (d / d1); // No overflow
+                    lword c2 = lword(n) * (a.den / d1); // No overflow
+                    lword t;
+                    CHECK_SUM_OVERFLOWS_LWORD(t, c1, c2);
+                    word zn;
+                    uword zd;
+                    if (t == 0) {
+                        zn = 0;
+                        zd = 1;
+                    } else {
+                        uword d2 = d1 == 1 ? 1 : gcd(uword(absVal(t) % d1), d1);
+                        CHECK_WORD(zn, t / lword(d2));
+                        CHECK_UWORD(zd, ulword(a.den / d1) * (d / d2));
+                    }
+                    a.num = zn;
+                    a.den = zd;
+                }
+            }
+            a.setOnlyWordPartValid();
+            assert(a.isWellFormed());
+            return;
+        }
+    }
+    overflow:
+    a.ensure_mpq_valid();
+    b.force_ensure_mpq_valid();
+    c.force_ensure_mpq_valid();
+    mpq_ptr product = FastRational::tempProduct.get_mpq_t();
+    mpq_mul(product, b.mpq, c.mpq);
+    mpq_add(a.mpq, a.mpq, product);
+    a.state = State::MPQ_ALLOCATED_AND_VALID;
+    a.try_fit_word();
+}
+
 inline void substractionAssign(FastRational& a, const FastRational& b) {
     if (a.wordPartValid() && b.wordPartValid()) {
         uword common = gcd(a.den, b.den);
@@ -94,6 +94,20 @@ SymRef ArithLogic::getPlusForSort(SRef sort) const {
     return sort == getSort_int() ? get_sym_Int_PLUS() : get_sym_Real_PLUS();
 }
 
+void ArithLogic::getInternalTerms(vec<PTRef>& out) const {
+    Logic::getInternalTerms(out);
+    for (PTRef tr : {term_Real_ZERO, term_Real_ONE, term_Real_MINUSONE, term_Int_ZERO, term_Int_ONE, term_Int_MINUSONE}) {
+        if (tr != PTRef_Undef) { out.push(tr); }
+    }
+}
+
+void ArithLogic::relocateInternalTerms(PtRelocation const & reloc) {
+    Logic::relocateInternalTerms(reloc);
+    for (PTRef * tr : {&term_Real_ZERO, &term_Real_ONE, &term_Real_MINUSONE, &term_Int_ZERO, &term_Int_ONE, &term_Int_MINUSONE}) {
+        if (*tr != PTRef_Undef) { *tr = reloc(*tr); }
+    }
+}
+
 SymRef ArithLogic::getTimesForSort(SRef sort) const {
     assert (sort == getSort_int() or sort == getSort_real());
     return sort == getSort_int() ? get_sym_Int_TIMES() : get_sym_Real_TIMES();
@@ -109,6 +109,12 @@ protected:
 public:
     ArithLogic(opensmt::Logic_t type);
     ~ArithLogic() { for (auto number : numbers) { delete number; } }
+
+protected:
+    void getInternalTerms(vec<PTRef>& out) const override;
+    void relocateInternalTerms(PtRelocation const & reloc) override;
+
+public:
     bool             isBuiltinFunction(SymRef sr) const override;
     PTRef            insertTerm       (SymRef sym, vec<PTRef> && terms) override;
     SRef             getSort_real     () const { return sort_REAL; }
@@ -72,7 +72,7 @@ BVLogic::BVLogic(opensmt::Logic_t type, int width) :
     , sym_BV_BWXOR(declareFun_NoScoping_LeftAssoc(tk_bv_bwxor, sort_BVNUM, {sort_BVNUM, sort_BVNUM}))
     , sym_BV_LSHIFT(declareFun_NoScoping_LeftAssoc(tk_bv_lshift, sort_BVNUM, {sort_BVNUM, sort_BVNUM}))
     , sym_BV_LRSHIFT(declareFun_NoScoping_LeftAssoc(tk_bv_lrshift, sort_BVNUM, {sort_BVNUM, sort_BVNUM}))
-    , sym_BV_ARSHIFT(declareFun_NoScoping_LeftAssoc(tk_bv_lrshift, sort_BVNUM, {sort_BVNUM, sort_BVNUM}))
+    , sym_BV_ARSHIFT(declareFun_NoScoping_LeftAssoc(tk_bv_arshift, sort_BVNUM, {sort_BVNUM, sort_BVNUM}))
     , sym_BV_MOD(declareFun_NoScoping_LeftAssoc(tk_bv_mod, sort_BVNUM, {sort_BVNUM, sort_BVNUM}))
     , sym_BV_BWOR(declareFun_NoScoping_LeftAssoc(tk_bv_bwor, sort_BVNUM, {sort_BVNUM, sort_BVNUM}))
     , sym_BV_BWAND(declareFun_NoScoping_LeftAssoc(tk_bv_bwand, sort_BVNUM, {sort_BVNUM, sort_BVNUM}))
@@ -97,6 +97,18 @@ BVLogic::BVLogic(opensmt::Logic_t type, int width) :
 BVLogic::~BVLogic()
 {}
 
+void BVLogic::getInternalTerms(vec<PTRef>& out) const {
+    CUFLogic::getInternalTerms(out);
+    out.push(term_BV_ZERO);
+    out.push(term_BV_ONE);
+}
+
+void BVLogic::relocateInternalTerms(PtRelocation const & reloc) {
+    CUFLogic::relocateInternalTerms(reloc);
+    term_BV_ZERO = reloc(term_BV_ZERO);
+    term_BV_ONE = reloc(term_BV_ONE);
+}
+
 PTRef
 BVLogic::mkBVEq(PTRef a1, PTRef a2)
 {
@@ -263,7 +275,7 @@ BVLogic::mkBVUlt(const PTRef arg1, const PTRef arg2)
 {
     assert(hasSortBVNUM(arg1));
     assert(hasSortBVNUM(arg2));
-    return mkBVNeg(mkBVUgeq(arg1, arg2));
+    return mkBVNot(mkBVUgeq(arg1, arg2));
 }
 
 PTRef
@@ -391,7 +403,14 @@ PTRef BVLogic::mkBVNeq(const PTRef a1, const PTRef a2)
     return mkBVNot(mkBVEq(args));
 }
 
+// The constants are written in binary in two's complement
 int BVLogic::getBVNUMConst(PTRef tr) const
 {
-    return atoi(getSymName(tr));
+    const char* bits = getSymName(tr);
+    unsigned value = 0;
+    for (int i = 0; bits[i] != '\0'; i++)
+        value = (value << 1) | (bits[i] == '1');
+    if (bitwidth < 32 && bits[0] == '1')
+        value |= ~0u << bitwidth;
+    return (int)value;
 }
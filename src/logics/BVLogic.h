@@ -108,9 +108,16 @@ class BVLogic: public CUFLogic
     virtual bool          isBuiltinSortSym(SSymRef ssr) const override { return (ssr == sort_store.getSortSym(sort_BVNUM)) || CUFLogic::isBuiltinSortSym(ssr); }
     virtual bool          isBuiltinSort(SRef sr) const override { return (sr == sort_BVNUM) /*|| (sr == sort_BVSTR)*/ || CUFLogic::isBuiltinSort(sr); }
     virtual bool          isBuiltinConstant(SymRef sr) const override { return isBVNUMConst(sr) || CUFLogic::isBuiltinConstant(sr); }
+    virtual PTRef         getDefaultValuePTRef(const SRef sref) const override { return sref == sort_BVNUM ? term_BV_ZERO : CUFLogic::getDefaultValuePTRef(sref); }
 
 //    virtual void conjoinExtras(PTRef root, PTRef& root_out) { root_out = root; }
 
+  protected:
+    void getInternalTerms(vec<PTRef>& out) const override;
+    void relocateInternalTerms(PtRelocation const & reloc) override;
+
+  public:
+
     bool isBVNUMConst(SymRef sr) const { return isConstant(sr) && hasSortBVNUM(sr); }
     bool isBVNUMConst(PTRef tr)  const { return isBVNUMConst(getPterm(tr).symb()); }
     bool hasSortBVNUM(const SymRef sr) const { return getSortRef(sr) == sort_BVNUM; }
@@ -145,6 +152,10 @@ class BVLogic: public CUFLogic
     bool isBVSgeq(PTRef tr)     const { return isBVSgeq(getPterm(tr).symb()); }
     bool isBVSgt(SymRef sr)     const { return sr == sym_BV_SGT; }
     bool isBVSgt(PTRef tr)      const { return isBVSgt(getPterm(tr).symb()); }
+    bool isBVUgeq(SymRef sr)    const { return sr == sym_BV_UGEQ; }
+    bool isBVUgeq(PTRef tr)     const { return isBVUgeq(getPterm(tr).symb()); }
+    bool isBVUgt(SymRef sr)     const { return sr == sym_BV_UGT; }
+    bool isBVUgt(PTRef tr)      const { return isBVUgt(getPterm(tr).symb()); }
     bool isBVVar(SymRef sr)    const { return isVar(sr) && sym_store[sr].rsort() == sort_BVNUM; }
     bool isBVVar(PTRef tr)     const { return isBVVar(getPterm(tr).symb()); }
     bool isBVZero(SymRef sr)   const { return sr == sym_BV_ZERO; }
@@ -254,8 +265,6 @@ class BVLogic: public CUFLogic
 
     PTRef mkBVEq      (const vec<PTRef>& args) {assert(args.size() == 2); return mkBVEq(args[0], args[1]);}
     PTRef mkBVEq      (const PTRef, const PTRef);
-    virtual PTRef mkEq(const PTRef a1, const PTRef a2) { if (hasSortBVNUM(a1)) assert(false); return CUFLogic::mkEq(a1, a2); }
-    virtual PTRef mkEq(vec<PTRef>&& args) { if (hasSortBVNUM(args[0])) assert(false); return CUFLogic::mkEq(std::move(args)); }
 
 
     PTRef mkBVNeq(const vec<PTRef>& args) {assert(args.size() == 2); return mkBVNeq(args[0], args[1]);}
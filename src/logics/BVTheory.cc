@@ -0,0 +1,18 @@
+#include "Theory.h"
+#include "OsmtApiException.h"
+
+//
+// Bit-blast the formulas of the frames up to curr.  The bit-blaster
+// keeps the bits of the terms it has seen, so that the formulas of the
+// earlier frames are not blasted again.
+//
+bool BVTheory::simplify(const vec<PFRef>& formulas, PartitionManager&, int curr)
+{
+    if (this->keepPartitions()) {
+        throw OsmtApiException("Interpolation is not supported in QF_BV");
+    }
+    auto & currentFrame = pfstore[formulas[curr]];
+    PTRef coll_f = getCollateFunction(formulas, curr);
+    currentFrame.root = tshandler.getBitBlaster().blast(coll_f);
+    return true;
+}
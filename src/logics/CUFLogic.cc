@@ -102,6 +102,26 @@ CUFLogic::CUFLogic(opensmt::Logic_t logicType) :
 CUFLogic::~CUFLogic()
 {}
 
+void CUFLogic::getInternalTerms(vec<PTRef>& out) const {
+    Logic::getInternalTerms(out);
+    out.push(term_CUF_ZERO);
+    out.push(term_CUF_ONE);
+    for (auto const * extras : {&comm_eqs, &diseq_eqs, &diseq_split, &mod_ineqs, &inc_diseqs, &compl_diseqs}) {
+        for (PTRef tr : extras->getKeys()) { out.push(tr); }
+    }
+}
+
+void CUFLogic::relocateInternalTerms(PtRelocation const & reloc) {
+    Logic::relocateInternalTerms(reloc);
+    term_CUF_ZERO = reloc(term_CUF_ZERO);
+    term_CUF_ONE = reloc(term_CUF_ONE);
+    for (auto * extras : {&comm_eqs, &diseq_eqs, &diseq_split, &mod_ineqs, &inc_diseqs, &compl_diseqs}) {
+        MapWithKeys<PTRef,bool,PTRefHash> relocated;
+        for (PTRef tr : extras->getKeys()) { relocated.insert(reloc(tr), (*extras)[tr]); }
+        *extras = std::move(relocated);
+    }
+}
+
 //PTRef
 //CUFLogic::insertTerm(SymRef sym, vec<PTRef>& terms, char **msg)
 //{
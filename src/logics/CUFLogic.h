@@ -120,6 +120,12 @@ class CUFLogic: public Logic
 
     PTRef conjoinExtras(PTRef root) override;
 
+  protected:
+    void getInternalTerms(vec<PTRef>& out) const override;
+    void relocateInternalTerms(PtRelocation const & reloc) override;
+
+  public:
+
     bool isCUFNUMConst(SymRef sr) const { return isConstant(sr) && hasSortCUFNUM(sr); }
     bool isCUFNUMConst(PTRef tr)  const { return isCUFNUMConst(getPterm(tr).symb()); }
     bool hasSortCUFNUM(const SymRef sr) const { return getSortRef(sr) == sort_CUFNUM; }
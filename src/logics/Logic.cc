@@ -68,12 +68,11 @@ const char* Logic::s_ite_prefix = ".oite";
 const char* Logic::s_framev_prefix = ".frame";
 const char* Logic::s_abstract_value_prefix = "@";
 
-std::size_t Logic::abstractValueCount = 0;
+std::atomic<std::size_t> Logic::abstractValueCount{0};
 
 // The constructor initiates the base logic (Boolean)
 Logic::Logic(opensmt::Logic_t _logicType) :
       logicType(_logicType)
-    , distinctClassCount(0)
     , sort_store()
     , term_store(sym_store)
     , sym_IndexedSort(sort_store.newSortSymbol(SortSymbol(tk_indexed, 2, SortSymbol::INTERNAL)))
@@ -103,6 +102,33 @@ Logic::Logic(opensmt::Logic_t _logicType) :
 
 Logic::~Logic() = default;
 
+PtStore::GCStats Logic::collectGarbage(vec<PTRef>& roots) {
+    vec<PTRef> allRoots;
+    getInternalTerms(allRoots);
+    for (PTRef root : roots) { allRoots.push(root); }
+    PtRelocation reloc;
+    PtStore::GCStats stats = term_store.garbageCollect(allRoots, reloc);
+    relocateInternalTerms(reloc);
+    for (PTRef & root : roots) { root = reloc(root); }
+    return stats;
+}
+
+void Logic::getInternalTerms(vec<PTRef>& out) const {
+    out.push(term_TRUE);
+    out.push(term_FALSE);
+    for (auto const & entry : defaultValueForSort.getKeysAndVals()) { out.push(entry.data); }
+    defined_functions.getTerms(out);
+    for (PTRef tr : propFormulasAppearingInUF) { out.push(tr); }
+}
+
+void Logic::relocateInternalTerms(PtRelocation const & reloc) {
+    term_TRUE = reloc(term_TRUE);
+    term_FALSE = reloc(term_FALSE);
+    for (auto entry : defaultValueForSort.getKeysAndValsPtrs()) { entry->data = reloc(entry->data); }
+    defined_functions.relocate(reloc);
+    for (PTRef & tr : propFormulasAppearingInUF) { tr = reloc(tr); }
+}
+
 bool Logic::isBuiltinFunction(const SymRef sr) const
 {
     if (sr == sym_TRUE || sr == sym_FALSE || sr == sym_AND || sr == sym_OR || sr == sym_XOR || sr == sym_NOT || sr == sym_EQ || sr == sym_IMPLIES || sr == sym_DISTINCT || sr == sym_ITE) return true;
@@ -616,8 +642,7 @@ PTRef Logic::mkEq(vec<PTRef>&& args) {
 
 // Given args = {a_1, ..., a_n}, distinct(args) holds iff
 // for all a_i, a_j \in args s.t. i != j: a_i != a_j
-// General distinctions are represented as separate terms until the distinction classes have been used up.
-// After this, they are written explicitly as the O(n^2) expansion.
+// General distinctions are represented as separate terms.
 PTRef Logic::mkDistinct(vec<PTRef>&& args) {
     if (args.size() == 0) return getTerm_true();
     if (args.size() == 1) return getTerm_true();
@@ -639,29 +664,11 @@ PTRef Logic::mkDistinct(vec<PTRef>&& args) {
 
     SymRef diseq_sym = term_store.lookupSymbol(tk_distinct, args);
     assert(!isBooleanOperator(diseq_sym));
-    PTLKey key;
-    key.sym = diseq_sym;
-    args.moveTo(key.args);
-    if (term_store.hasCplxKey(key)) {
-        return term_store.getFromCplxMap(key);
-    }
-    else {
-        if (distinctClassCount < maxDistinctClasses) {
-            PTRef res = term_store.newTerm(diseq_sym, key.args);
-            term_store.addToCplxMap(std::move(key), res);
-            distinctClassCount++;
-            return res;
-        }
-        else {
-            vec<PTRef> distinct_terms;
-            for (int i = 0; i < key.args.size(); i++) {
-                for (int j = i + 1; j < key.args.size(); j++) {
-                    distinct_terms.push(mkDistinct({key.args[i], key.args[j]}));
-                }
-            }
-            return mkAnd(std::move(distinct_terms));
-        }
+    PTRef res = term_store.lookupCplx(diseq_sym, args);
+    if (res != PTRef_Undef) {
+        return res;
     }
+    return term_store.newCplxTerm(diseq_sym, args);
 }
 
 PTRef Logic::mkNot(vec<PTRef>&& args) {
@@ -867,26 +874,17 @@ Logic::mkFun(SymRef sym, vec<PTRef>&& terms)
         {
             throw OsmtApiException(e_argnum_mismatch);
         }
-        PTLKey k;
-        k.sym = sym;
-        terms.moveTo(k.args);
         if (sym_store[sym].commutes()) {
-            termSort(k.args);
-        }
-        if (term_store.hasCplxKey(k))
-            res = term_store.getFromCplxMap(k);
-        else {
-            res = term_store.newTerm(sym, k.args);
-            term_store.addToCplxMap(std::move(k), res);
+            termSort(terms);
         }
+        res = term_store.lookupCplx(sym, terms);
+        if (res == PTRef_Undef)
+            res = term_store.newCplxTerm(sym, terms);
     }
     else {
         // Boolean operator
-        PTLKey k;
-        k.sym = sym;
-        terms.moveTo(k.args);
-        if (term_store.hasBoolKey(k)) {//bool_map.contains(k)) {
-            res = term_store.getFromBoolMap(k); //bool_map[k];
+        res = term_store.lookupCplx(sym, terms);
+        if (res != PTRef_Undef) {
 #ifdef SIMPLIFY_DEBUG
             char* ts = printTerm(res);
             cerr << "duplicate: " << ts << endl;
@@ -894,8 +892,7 @@ Logic::mkFun(SymRef sym, vec<PTRef>&& terms)
 #endif
         }
         else {
-            res = term_store.newTerm(sym, k.args);
-            term_store.addToBoolMap(std::move(k), res);
+            res = term_store.newCplxTerm(sym, terms);
 #ifdef SIMPLIFY_DEBUG
             char* ts = printTerm(res);
             cerr << "new: " << ts << endl;
@@ -939,13 +936,7 @@ PTRef Logic::hasEquality(vec<PTRef>& args)
     SymRef sref = term_store.lookupSymbol(tk_equals, args);
     assert(sref != SymRef_Undef);
     termSort(args);
-    PTLKey k;
-    k.sym = sref;
-    args.copyTo(k.args);
-    if (term_store.hasCplxKey(k))
-        return term_store.getFromCplxMap(k);
-    else
-        return PTRef_Undef;
+    return term_store.lookupCplx(sref, args);
 }
 
 bool Logic::isBooleanOperator(SymRef tr) const {
@@ -29,12 +29,12 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "SymStore.h"
 #include "PtStore.h"
 #include "SStore.h"
-#include "CgTypes.h"
 #include "LogicFactory.h"
 #include "MapWithKeys.h"
 #include "OsmtApiException.h"
 #include "FunctionTools.h"
 #include "TypeUtils.h"
+#include <atomic>
 #include <cassert>
 #include <cstring>
 #include <cstdlib>
@@ -46,7 +46,7 @@ class Logic {
   public:
     using SubstMap = MapWithKeys<PTRef,PTRef,PTRefHash>;
   protected:
-    static std::size_t abstractValueCount;
+    static std::atomic<std::size_t> abstractValueCount; // Shared by the logics of all threads
     static const char* e_argnum_mismatch;
     static const char* e_bad_constant;
 
@@ -62,7 +62,6 @@ class Logic {
     opensmt::Logic_t const logicType;
 
     bool isKnownToUser(SymRef sr) const { return getSymName(sr)[0] != s_abstract_value_prefix[0]; }
-    int distinctClassCount;
 
     class DefinedFunctions {
         std::unordered_map<std::string,TemplateFunction> defined_functions;
@@ -87,6 +86,22 @@ class Logic {
                 keys_out.push(strdup(k.c_str()));
             }
         }
+
+        void getTerms(vec<PTRef> & terms_out) const {
+            for (auto const & entry : defined_functions) {
+                for (PTRef arg : entry.second.getArgs()) { terms_out.push(arg); }
+                terms_out.push(entry.second.getBody());
+            }
+        }
+
+        void relocate(PtRelocation const & reloc) {
+            for (auto & entry : defined_functions) {
+                TemplateFunction & templ = entry.second;
+                vec<PTRef> args;
+                for (PTRef arg : templ.getArgs()) { args.push(reloc(arg)); }
+                templ = TemplateFunction(templ.getName(), args, templ.getRetSort(), reloc(templ.getBody()));
+            }
+        }
     };
     DefinedFunctions defined_functions;
 
@@ -162,7 +177,20 @@ class Logic {
     bool hasIntegers() const { return opensmt::QFLogicToProperties.at(logicType).arithProperty.hasInts; }
     bool hasReals() const { return opensmt::QFLogicToProperties.at(logicType).arithProperty.hasReals; }
 
+    /**
+     * Garbage collection of the term store.  The terms reachable from roots or from the terms the logic itself
+     * refers to survive, all other terms are removed, and the surviving terms get new references.  Roots are updated
+     * in place.  The caller is responsible for there being no other references to the terms, e.g., in a MainSolver
+     * built on this logic.
+     */
+    PtStore::GCStats collectGarbage(vec<PTRef>& roots);
+
   protected:
+    // The terms the logic refers to internally; these survive every garbage collection
+    virtual void getInternalTerms(vec<PTRef>& out) const;
+    // Updates the internal references of the logic after garbage collection
+    virtual void relocateInternalTerms(PtRelocation const & reloc);
+
     PTRef       mkFun         (SymRef f, vec<PTRef>&& args);
     void        markConstant  (PTRef ptr);
     void        markConstant  (SymId sid);
@@ -55,6 +55,7 @@ Logic * opensmt::LogicFactory::getInstance(Logic_t logicType) {
             break;
         }
         case Logic_t::QF_CUF:
+        case Logic_t::QF_BV:
         {
             l = new BVLogic(logicType);
             break;
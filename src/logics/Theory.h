@@ -34,6 +34,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "UFTHandler.h"
 #include "CUFTHandler.h"
+#include "BVTHandler.h"
 #include "Alloc.h"
 
 #include "PartitionManager.h"
@@ -214,4 +215,28 @@ class CUFTheory : public Theory
     virtual bool simplify(const vec<PFRef>&, PartitionManager& pmanager, int) override;
 };
 
+//
+// QF_BV is solved by eager bit-blasting: the simplified formula of each
+// frame is replaced by its bit-blasted form before it reaches the SAT
+// solver.
+//
+class BVTheory : public Theory
+{
+  private:
+    BVLogic &  bvlogic;
+    BVTHandler tshandler;
+  public:
+    BVTheory(SMTConfig & c, BVLogic & logic)
+      : Theory(c)
+      , bvlogic(logic)
+      , tshandler(c, bvlogic)
+    { }
+    ~BVTheory() {}
+    virtual BVLogic&          getLogic() override { return bvlogic; }
+    virtual const BVLogic&    getLogic() const override { return bvlogic; }
+    virtual BVTHandler&       getTSolverHandler() override { return tshandler; }
+    virtual const BVTHandler& getTSolverHandler() const { return tshandler; }
+    virtual bool simplify(const vec<PFRef>&, PartitionManager& pmanager, int) override;
+};
+
 #endif
@@ -15,8 +15,12 @@ bool UFLATheory::simplify(const vec<PFRef>& formulas, PartitionManager &, int cu
         PTRef fla = flaFromSubstitutionResult(subs_res);
         PTRef purified = purify(fla);
         PTRef noArithmeticEqualities = splitArithmeticEqualities(purified);
-        PTRef enriched = addInterfaceClauses(noArithmeticEqualities);
-        currentFrame.root = enriched;
+        if (config.uf_la_eager_combination()) {
+            currentFrame.root = addInterfaceClauses(noArithmeticEqualities);
+        } else {
+            uflatshandler.addInterfaceVars(collectInterfaceVars(noArithmeticEqualities));
+            currentFrame.root = noArithmeticEqualities;
+        }
     }
     return true;
 }
@@ -196,11 +200,17 @@ public:
     }
 };
 
-PTRef UFLATheory::addInterfaceClauses(PTRef fla) {
-    if (not logic.isAnd(fla)) { return fla; }
+vec<PTRef> UFLATheory::collectInterfaceVars(PTRef fla) {
     CollectInterfaceVariablesConfig config(logic);
     TermVisitor(logic, config).visit(fla);
-    vec<PTRef> const & interfaceVars = config.getInterfaceVars();
+    vec<PTRef> interfaceVars;
+    config.getInterfaceVars().copyTo(interfaceVars);
+    return interfaceVars;
+}
+
+PTRef UFLATheory::addInterfaceClauses(PTRef fla) {
+    if (not logic.isAnd(fla)) { return fla; }
+    vec<PTRef> interfaceVars = collectInterfaceVars(fla);
     // Add all interface clauses to the formula
     vec<PTRef> interfaceClauses;
     for (int i = 0; i < interfaceVars.size(); ++i) {
@@ -49,7 +49,8 @@ class UFLATheory : public Theory
 protected:
     PTRef purify(PTRef fla);
     PTRef splitArithmeticEqualities(PTRef fla);
-    PTRef addInterfaceClauses(PTRef fla);
+    vec<PTRef> collectInterfaceVars(PTRef fla);
+    PTRef addInterfaceClauses(PTRef fla);           // Eager theory combination; otherwise the handler combines the models
 };
 
 #endif
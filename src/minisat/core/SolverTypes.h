@@ -23,6 +23,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #define Minisat_SolverTypes_h
 
 #include <assert.h>
+#include <algorithm>
 
 #include "osmtinttypes.h"
 #include "Alg.h"
@@ -140,7 +141,11 @@ class Clause {
         unsigned learnt    : 1;
         unsigned has_extra : 1;
         unsigned reloced   : 1;
-        unsigned size      : 27; }                            header;
+        unsigned size      : 27;
+        unsigned lbd       : 28;
+        unsigned tier      : 2;
+        unsigned used      : 1;
+        unsigned unused    : 1; }                            header;
     union { Lit lit; float act; uint32_t abs; CRef rel; } data[0];
 
     friend class ClauseAllocator;
@@ -153,6 +158,10 @@ class Clause {
         header.has_extra = use_extra;
         header.reloced   = 0;
         header.size      = ps.size();
+        header.lbd       = std::min<unsigned>(ps.size(), max_lbd);
+        header.tier      = tier_local;
+        header.used      = 0;
+        header.unused    = 0;
 
         for (unsigned i = 0; i < (unsigned)ps.size(); i++)
             data[i].lit = ps[i];
@@ -165,6 +174,10 @@ class Clause {
     }
 
 public:
+    // Learnt clauses are kept in one of three tiers according to their literal block distance (LBD)
+    enum : uint32_t { tier_core = 0, tier_mid = 1, tier_local = 2 };
+    static constexpr uint32_t max_lbd = (1u << 28) - 1;
+
     void calcAbstraction() {
         assert(header.has_extra);
         uint32_t abstraction = 0;
@@ -186,6 +199,13 @@ public:
     CRef         relocation  ()      const   { return data[0].rel; }
     void         relocate    (CRef c)        { header.reloced = 1; data[0].rel = c; }
 
+    uint32_t     lbd         ()      const   { return header.lbd; }
+    void         lbd         (uint32_t l)    { header.lbd = std::min(l, max_lbd); }
+    uint32_t     tier        ()      const   { return header.tier; }
+    void         tier        (uint32_t t)    { header.tier = t; }
+    bool         used        ()      const   { return header.used; }
+    void         used        (bool u)        { header.used = u; }
+
     // NOTE: somewhat unsafe to change the clause in-place! Must manually call 'calcAbstraction' afterwards for
     //       subsumption operations to behave correctly.
     Lit&         operator [] (int i)         { return data[i].lit; }
@@ -260,6 +280,9 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
         // Copy extra data-fields:
         // (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
         to[cr].mark(c.mark());
+        to[cr].lbd(c.lbd());
+        to[cr].tier(c.tier());
+        to[cr].used(c.used());
         if (to[cr].learnt())         to[cr].activity() = c.activity();
         else if (to[cr].has_extra()) to[cr].calcAbstraction();
     }
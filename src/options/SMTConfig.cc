@@ -395,6 +395,57 @@ bool SMTConfig::setOption(const char* name, const SMTOption& value, const char*&
         if (seed == 0) { msg = s_err_seed_zero; return false; }
     }
 
+    if (strcmp(name, o_threads) == 0) {
+        if (value.getValue().type != O_NUM) { msg = s_err_not_num; return false; }
+        if (value.getValue().numval < 1) { msg = s_err_threads; return false; }
+    }
+
+    if (strcmp(name, o_lia_cut_budget) == 0) {
+        if (value.getValue().type != O_NUM) { msg = s_err_not_num; return false; }
+        if (value.getValue().numval < 0) { msg = s_err_cut_budget; return false; }
+    }
+
+    if (strcmp(name, o_lra_propagation_row_size) == 0) {
+        if (value.getValue().type != O_NUM) { msg = s_err_not_num; return false; }
+        if (value.getValue().numval < 0) { msg = s_err_row_size; return false; }
+    }
+
+    if (strcmp(name, o_lra_pivoting_rule) == 0) {
+        if (value.getValue().type != O_STR) { msg = s_err_not_str; return false; }
+        const char* val = value.getValue().strval;
+        if (strcmp(val, lrapivs_shortest_row) != 0 &&
+                strcmp(val, lrapivs_devex) != 0)
+        { msg = s_err_unknown_pivoting_rule; return false; }
+    }
+
+    if (strcmp(name, o_lra_bland_threshold) == 0) {
+        if (value.getValue().type != O_NUM) { msg = s_err_not_num; return false; }
+        if (value.getValue().numval < 0) { msg = s_err_bland_threshold; return false; }
+    }
+
+    if (strcmp(name, o_uf_minimize_explanations) == 0) {
+        if (value.getValue().type != O_NUM) { msg = s_err_not_num; return false; }
+        if (value.getValue().numval < 0) { msg = s_err_explanation_size; return false; }
+    }
+
+    if (strcmp(name, o_stp_propagation_limit) == 0) {
+        if (value.getValue().type != O_NUM) { msg = s_err_not_num; return false; }
+        if (value.getValue().numval < 0) { msg = s_err_propagation_limit; return false; }
+    }
+
+    if (strcmp(name, o_sat_lbd_core) == 0 || strcmp(name, o_sat_lbd_tier2) == 0) {
+        if (value.getValue().type != O_NUM) { msg = s_err_not_num; return false; }
+        if (value.getValue().numval < 0) { msg = s_err_lbd_threshold; return false; }
+    }
+
+    if (strcmp(name, o_uf_la_combination) == 0) {
+        if (value.getValue().type != O_STR) { msg = s_err_not_str; return false; }
+        const char* val = value.getValue().strval;
+        if (strcmp(val, uflacombs_model) != 0 &&
+                strcmp(val, uflacombs_eager) != 0)
+        { msg = s_err_unknown_combination; return false; }
+    }
+
     if (strcmp(name, o_sat_split_type) == 0) {
         if (value.getValue().type != O_STR) { msg = s_err_not_str; return false; }
         const char* val = value.getValue().strval;
@@ -492,6 +543,7 @@ const char* SMTConfig::o_dump_state = ":dump-state";
 const char* SMTConfig::o_time_queries = ":time-queries";
 const char* SMTConfig::o_output_dir = ":output-dir";
 const char* SMTConfig::o_ghost_vars = ":ghost-vars";
+const char* SMTConfig::o_threads = ":threads";
 const char* SMTConfig::o_dump_query = ":dump-query";
 const char* SMTConfig::o_dump_query_name = ":dump-query-name";
 const char* SMTConfig::o_inst_name = ":instance-name";
@@ -515,8 +567,18 @@ const char* SMTConfig::o_smt_split_format = ":split-format";
 const char* SMTConfig::o_smt_split_format_length = ":split-format-length"; // brief or full: output the constraints only, or the full problem
 const char* SMTConfig::o_respect_logic_partitioning_hints = ":respect-logic-partitioning-hints"; // Logic can have a say whether a var is good for partitioning
 const char* SMTConfig::o_sat_lookahead_split = ":lookahead-split";
+const char* SMTConfig::o_sat_split_conquer = ":conquer-splits";
 const char* SMTConfig::o_sat_pure_lookahead = ":pure-lookahead";
 const char* SMTConfig::o_lookahead_score_deep = ":lookahead-score-deep";
+const char* SMTConfig::o_lia_cut_budget = ":lia-cut-budget";
+const char* SMTConfig::o_lra_propagation_row_size = ":lra-propagation-row-size";
+const char* SMTConfig::o_lra_pivoting_rule = ":lra-pivoting-rule";
+const char* SMTConfig::o_lra_bland_threshold = ":lra-bland-threshold";
+const char* SMTConfig::o_stp_propagation_limit = ":stp-propagation-limit";
+const char* SMTConfig::o_sat_lbd_core = ":sat-lbd-core";
+const char* SMTConfig::o_sat_lbd_tier2 = ":sat-lbd-tier2";
+const char* SMTConfig::o_uf_la_combination = ":uf-la-combination";
+const char* SMTConfig::o_uf_minimize_explanations = ":uf-minimize-explanations";
 
 char* SMTConfig::server_host=NULL;
 uint16_t SMTConfig::server_port = 0;
@@ -530,6 +592,15 @@ const char* SMTConfig::s_err_not_num = "expected number";
 const char* SMTConfig::s_err_seed_zero = "seed cannot be 0";
 const char* SMTConfig::s_err_unknown_split = "unknown split type";
 const char* SMTConfig::s_err_unknown_units = "unknown split units";
+const char* SMTConfig::s_err_threads = "number of threads must be positive";
+const char* SMTConfig::s_err_cut_budget = "cut budget cannot be negative";
+const char* SMTConfig::s_err_row_size = "row size cannot be negative";
+const char* SMTConfig::s_err_unknown_pivoting_rule = "unknown pivoting rule";
+const char* SMTConfig::s_err_bland_threshold = "Bland threshold cannot be negative";
+const char* SMTConfig::s_err_propagation_limit = "propagation limit cannot be negative";
+const char* SMTConfig::s_err_explanation_size = "explanation size cannot be negative";
+const char* SMTConfig::s_err_lbd_threshold = "LBD threshold cannot be negative";
+const char* SMTConfig::s_err_unknown_combination = "unknown theory combination";
 
 void
 SMTConfig::initializeConfig( )
@@ -592,6 +663,24 @@ SMTConfig::initializeConfig( )
   cuf_bitwidth                   = 32;
 }
 
+void
+SMTConfig::inheritOptions( SMTConfig const & other )
+{
+  for (const char* name : other.option_names) {
+      if (strcmp(name, o_produce_stats) == 0 || strcmp(name, o_stats_out) == 0 || !other.optionTable.has(name))
+          continue;
+      insertOption(name, new SMTOption(*other.optionTable[name]));
+  }
+  sat_use_luby_restart           = other.sat_use_luby_restart;
+  sat_preprocess_booleans        = other.sat_preprocess_booleans;
+  sat_theory_polarity_suggestion = other.sat_theory_polarity_suggestion;
+  sat_lazy_dtc                   = other.sat_lazy_dtc;
+  sat_lazy_dtc_burst             = other.sat_lazy_dtc_burst;
+  uf_disable                     = other.uf_disable;
+  lra_poly_deduct_size           = other.lra_poly_deduct_size;
+  lra_check_on_assert            = other.lra_check_on_assert;
+}
+
 void
 SMTConfig::parseCMDLine( int argc
                        , char * argv[ ] )
@@ -188,6 +188,12 @@ static const char* const spts_none      = "none";
 static const char* const spts_decisions = "decisions";
 static const char* const spts_time      = "time";
 
+static const char* const lrapivs_shortest_row = "shortest-row";
+static const char* const lrapivs_devex        = "devex";
+
+static const char* const uflacombs_model = "model";
+static const char* const uflacombs_eager = "eager";
+
 static const char* const spprefs_tterm   = "tterm";
 static const char* const spprefs_blind   = "blind";
 static const char* const spprefs_bterm   = "bterm";
@@ -290,6 +296,7 @@ public:
   static const char* o_sat_split_fix_vars; // Like split_num, but give the number of vars to fix instead
   static const char* o_sat_split_asap;
   static const char* o_sat_lookahead_split;
+  static const char* o_sat_split_conquer;
   static const char* o_sat_pure_lookahead;
   static const char* o_lookahead_score_deep;
   static const char* o_sat_split_units;
@@ -306,6 +313,26 @@ public:
   static const char* o_respect_logic_partitioning_hints;
   static const char* o_output_dir;
   static const char* o_ghost_vars;
+  // Number of diversified solvers run in parallel by the portfolio mode (1 disables the mode)
+  static const char* o_threads;
+  // Maximal number of cutting planes the LIA solver derives before relying on branch-and-bound only (0 disables cuts)
+  static const char* o_lia_cut_budget;
+  // Maximal number of terms of a row the LA solver uses for theory propagation of bounds (0 disables row propagation)
+  static const char* o_lra_propagation_row_size;
+  // Pivoting rule of the simplex: shortest-row (default) or devex
+  static const char* o_lra_pivoting_rule;
+  // Number of pivots in one check after which the simplex switches to Bland's rule (0 uses the number of columns)
+  static const char* o_lra_bland_threshold;
+  // Maximal number of vertices the difference logic solver settles in each direction when propagating an asserted edge (0 means no limit)
+  static const char* o_stp_propagation_limit;
+  // Learnt clauses with LBD at most this value are kept in the core tier and never removed
+  static const char* o_sat_lbd_core;
+  // Learnt clauses with LBD at most this value are kept in the middle tier while they take part in conflicts
+  static const char* o_sat_lbd_tier2;
+  // Combination of UF and arithmetic: model (default) proposes the equalities of the arithmetic model, eager adds all interface clauses
+  static const char* o_uf_la_combination;
+  // Maximal number of literals of an explanation of the egraph that is minimized (0 disables minimization)
+  static const char* o_uf_minimize_explanations;
 
 private:
 
@@ -315,6 +342,15 @@ private:
   static const char* s_err_seed_zero;
   static const char* s_err_unknown_split;
   static const char* s_err_unknown_units;
+  static const char* s_err_threads;
+  static const char* s_err_cut_budget;
+  static const char* s_err_row_size;
+  static const char* s_err_unknown_pivoting_rule;
+  static const char* s_err_bland_threshold;
+  static const char* s_err_propagation_limit;
+  static const char* s_err_explanation_size;
+  static const char* s_err_lbd_threshold;
+  static const char* s_err_unknown_combination;
 
 
   Info          info_Empty;
@@ -406,6 +442,7 @@ public:
   const Info&   getInfo  (const char* name) const;
 
   void initializeConfig ( );
+  void inheritOptions   ( SMTConfig const & other ); // Copy the options (except statistics output) of other to this config
 
   void parseConfig      ( char * );
   void parseCMDLine     ( int argc, char * argv[ ] );
@@ -759,6 +796,10 @@ public:
       return optionTable.has(o_sat_lookahead_split) ?
               optionTable[o_sat_lookahead_split]->getValue().numval :
               0; }
+  int sat_split_conquer() const {
+      return optionTable.has(o_sat_split_conquer) ?
+              optionTable[o_sat_split_conquer]->getValue().numval :
+              0; }
   int sat_pure_lookahead() const {
       return optionTable.has(o_sat_pure_lookahead) ?
               optionTable[o_sat_pure_lookahead]->getValue().numval :
@@ -767,6 +808,40 @@ public:
       return optionTable.has(o_lookahead_score_deep) ?
               optionTable[o_lookahead_score_deep]->getValue().numval :
               0; }
+  int lia_cut_budget() const {
+      return optionTable.has(o_lia_cut_budget) ?
+              optionTable[o_lia_cut_budget]->getValue().numval :
+              1000; }
+  int lra_propagation_row_size() const {
+      return optionTable.has(o_lra_propagation_row_size) ?
+              optionTable[o_lra_propagation_row_size]->getValue().numval :
+              16; }
+  bool lra_devex_pivoting() const {
+      return optionTable.has(o_lra_pivoting_rule) &&
+              strcmp(optionTable[o_lra_pivoting_rule]->getValue().strval, lrapivs_devex) == 0; }
+  int lra_bland_threshold() const {
+      return optionTable.has(o_lra_bland_threshold) ?
+              optionTable[o_lra_bland_threshold]->getValue().numval :
+              0; }
+  int uf_minimize_explanations() const {
+      return optionTable.has(o_uf_minimize_explanations) ?
+              optionTable[o_uf_minimize_explanations]->getValue().numval :
+              0; }
+  int stp_propagation_limit() const {
+      return optionTable.has(o_stp_propagation_limit) ?
+              optionTable[o_stp_propagation_limit]->getValue().numval :
+              0; }
+  int sat_lbd_core() const {
+      return optionTable.has(o_sat_lbd_core) ?
+              optionTable[o_sat_lbd_core]->getValue().numval :
+              2; }
+  int sat_lbd_tier2() const {
+      return optionTable.has(o_sat_lbd_tier2) ?
+              optionTable[o_sat_lbd_tier2]->getValue().numval :
+              6; }
+  bool uf_la_eager_combination() const {
+      return optionTable.has(o_uf_la_combination) &&
+              strcmp(optionTable[o_uf_la_combination]->getValue().strval, uflacombs_eager) == 0; }
   int randomize_lookahead() const {
       return optionTable.has(o_sat_split_randomize_lookahead) ?
               optionTable[o_sat_split_randomize_lookahead]->getValue().numval :
@@ -806,6 +881,10 @@ public:
       return false;
   }
 
+  int threads() const
+    { return optionTable.has(o_threads) ?
+        optionTable[o_threads]->getValue().numval : 1; }
+
   int do_substitutions() const
     { return optionTable.has(o_do_substitutions) ?
         optionTable[o_do_substitutions]->getValue().numval : 1; }
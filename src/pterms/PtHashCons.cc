@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "PtHashCons.h"
+
+PTRef PtHashCons::find(SymRef sym, vec<PTRef> const & args, PtermAllocator const & pta) const {
+    uint32_t const h = hash(sym, args.begin(), args.size());
+    for (uint32_t i = h & mask(); slots[i].tr != PTRef_Undef; i = (i + 1) & mask()) {
+        if (slots[i].hash != h) { continue; }
+        Pterm const & t = pta[slots[i].tr];
+        if (t.symb() != sym or t.size() != args.size()) { continue; }
+        int j = 0;
+        for (; j < args.size() and t[j] == args[j]; j++);
+        if (j == args.size()) { return slots[i].tr; }
+    }
+    return PTRef_Undef;
+}
+
+void PtHashCons::insert(PTRef tr, PtermAllocator const & pta) {
+    // Keep the load factor below one half so that probe sequences stay short
+    if (2 * (count + 1) > slots.size()) { grow(); }
+    Pterm const & t = pta[tr];
+    uint32_t const h = hash(t.symb(), t.begin(), t.size());
+    uint32_t i = h & mask();
+    while (slots[i].tr != PTRef_Undef) { i = (i + 1) & mask(); }
+    slots[i] = {h, tr};
+    ++count;
+}
+
+void PtHashCons::grow() {
+    std::vector<Slot> old(2 * slots.size(), Slot{0, PTRef_Undef});
+    old.swap(slots);
+    for (Slot const & s : old) {
+        if (s.tr == PTRef_Undef) { continue; }
+        uint32_t i = s.hash & mask();
+        while (slots[i].tr != PTRef_Undef) { i = (i + 1) & mask(); }
+        slots[i] = s;
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OPENSMT_PTHASHCONS_H
+#define OPENSMT_PTHASHCONS_H
+
+#include "Pterm.h"
+
+#include <vector>
+
+/**
+ * Open-addressing hash-consing table for the terms with arguments.
+ *
+ * The table is keyed directly on the terms stored in a PtermAllocator:  a slot holds only the
+ * reference to the term and the hash of its structure, and a lookup compares the queried symbol and
+ * arguments against the term in the arena.  Consequently neither lookups nor insertions copy keys.
+ * Stored hashes make rehashing independent of the arena and filter out most mismatches without
+ * touching the term.
+ */
+class PtHashCons {
+    struct Slot {
+        uint32_t hash;
+        PTRef    tr;
+    };
+
+    std::vector<Slot> slots;     // Size is always a power of two
+    uint32_t          count = 0;
+
+    static constexpr uint32_t initCapacity = 1024;
+
+    static inline uint32_t rotl(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+    static inline uint32_t mix(uint32_t k) {
+        k *= 0xcc9e2d51;
+        k = rotl(k, 15);
+        return k * 0x1b873593;
+    }
+    static inline uint32_t finalize(uint32_t h) {
+        h ^= h >> 16;
+        h *= 0x85ebca6b;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35;
+        return h ^ (h >> 16);
+    }
+
+    uint32_t mask() const { return static_cast<uint32_t>(slots.size()) - 1; }
+    void grow();
+
+public:
+    PtHashCons() : slots(initCapacity, Slot{0, PTRef_Undef}) {}
+
+    // Position-sensitive structural hash of the term sym(args[0], ..., args[nargs-1]) (MurmurHash3 mixing)
+    static uint32_t hash(SymRef sym, PTRef const * args, int nargs) {
+        uint32_t h = mix(sym.x);
+        for (int i = 0; i < nargs; i++) {
+            h ^= mix(args[i].x);
+            h = rotl(h, 13) * 5 + 0xe6546b64;
+        }
+        return finalize(h ^ static_cast<uint32_t>(nargs));
+    }
+
+    // Returns the term sym(args) if it is in the table, PTRef_Undef otherwise
+    PTRef find(SymRef sym, vec<PTRef> const & args, PtermAllocator const & pta) const;
+    // Registers the term tr; the caller ensures that no structurally equal term is in the table
+    void insert(PTRef tr, PtermAllocator const & pta);
+
+    uint32_t size() const { return count; }
+};
+
+#endif //OPENSMT_PTHASHCONS_H
@@ -113,7 +113,9 @@ SymRef PtStore::lookupSymbol(const char* s, const vec<PTRef>& args) {
 }
 
 
+// Terms removed by garbage collection leave holes in idToPTRef; the iterator skips them
 PTRef PtermIter::operator* () {
+    while (i < idToPTRef.size() and idToPTRef[i] == PTRef_Undef) { i++; }
     if (i < idToPTRef.size())
         return idToPTRef[i];
     else
@@ -121,6 +123,17 @@ PTRef PtermIter::operator* () {
 }
 const PtermIter& PtermIter::operator++ () { i++; return *this; }
 
+PTRef PtRelocation::operator() (PTRef tr) const {
+    int lo = 0;
+    int hi = from.size();
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (from[mid].x < tr.x) { lo = mid + 1; }
+        else { hi = mid; }
+    }
+    return lo < from.size() and from[lo] == tr ? to[lo] : PTRef_Undef;
+}
+
 
 PTRef PtStore::newTerm(const SymRef sym, const vec<PTRef>& ps) {
     PTRef tr = pta.alloc(sym, ps); idToPTRef.push(tr);
@@ -139,13 +152,71 @@ bool  PtStore::hasCtermKey    (SymRef& k)             { return cterm_map.has(k);
 void  PtStore::addToCtermMap  (SymRef& k, PTRef tr)   { cterm_map.insert(k, tr); }
 PTRef PtStore::getFromCtermMap(SymRef& k)             { return cterm_map[k]; }
 
-bool  PtStore::hasBoolKey     (const PTLKey& k)       { return bool_map.find(k) != bool_map.end(); }
-void  PtStore::addToBoolMap   (PTLKey &&k, PTRef tr)  { bool_map[std::move(k)] = tr; }
-PTRef PtStore::getFromBoolMap (const PTLKey& k)       { return bool_map.at(k); }
+PTRef PtStore::lookupCplx(SymRef sym, const vec<PTRef>& args) const { return cplx_table.find(sym, args, pta); }
 
-bool  PtStore::hasCplxKey     (const PTLKey& k)       { return cplx_map.find(k) != cplx_map.end(); }
-void  PtStore::addToCplxMap   (PTLKey && k, PTRef tr) { cplx_map[std::move(k)] = tr; }
-PTRef PtStore::getFromCplxMap (const PTLKey& k)       { return cplx_map.at(k); }
+PTRef PtStore::newCplxTerm(SymRef sym, const vec<PTRef>& args) {
+    assert(lookupCplx(sym, args) == PTRef_Undef);
+    PTRef tr = newTerm(sym, args);
+    cplx_table.insert(tr, pta);
+    return tr;
+}
 
 PtermIter PtStore::getPtermIter() { return PtermIter(idToPTRef); }
 
+
+PtStore::GCStats PtStore::garbageCollect(vec<PTRef>& roots, PtRelocation& reloc) {
+    GCStats stats;
+
+    // Mark
+    vec<char> live;
+    live.growTo(idToPTRef.size(), false);
+    uint32_t liveWords = 0;
+    vec<PTRef> queue;
+    for (PTRef root : roots) { queue.push(root); }
+    while (queue.size() > 0) {
+        PTRef tr = queue.last();
+        queue.pop();
+        Pterm const & t = pta[tr];
+        uint32_t id = Idx(t.getId());
+        if (live[id]) { continue; }
+        live[id] = true;
+        liveWords += PtermAllocator::ptermWord32Size(t.size());
+        for (PTRef child : t) { queue.push(child); }
+    }
+
+    // Compact.  Arguments always have a smaller id than their parent, so processing the terms in the order of
+    // their ids guarantees that the arguments have already been relocated.
+    PtermAllocator to(std::max(liveWords, 1u));
+    to.n_terms = pta.n_terms;
+    PtHashCons table;
+    cterm_map.clear();
+    reloc.from.clear();
+    reloc.to.clear();
+    for (int id = 0; id < idToPTRef.size(); id++) {
+        PTRef old = idToPTRef[id];
+        if (old == PTRef_Undef) { continue; }
+        if (not live[id]) {
+            idToPTRef[id] = PTRef_Undef;
+            ++stats.collectedTerms;
+            continue;
+        }
+        PTRef tr = to.alloc(pta[old]);
+        Pterm & t = to[tr];
+        for (int i = 0; i < t.size(); i++) {
+            t[i] = idToPTRef[Idx(pta[t[i]].getId())];
+            assert(t[i] != PTRef_Undef);
+        }
+        idToPTRef[id] = tr;
+        reloc.from.push(old);
+        reloc.to.push(tr);
+        if (t.size() == 0) { cterm_map.insert(t.symb(), tr); }
+        else { table.insert(tr, to); }
+        ++stats.liveTerms;
+    }
+    for (PTRef & root : roots) { root = idToPTRef[Idx(pta[root].getId())]; }
+
+    stats.reclaimedBytes = static_cast<std::size_t>(pta.size() - to.size()) * PtermAllocator::Unit_Size;
+    cplx_table = std::move(table);
+    to.moveTo(pta);
+    return stats;
+}
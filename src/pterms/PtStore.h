@@ -28,8 +28,8 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define PTSTORE_H
 
 #include "Pterm.h"
+#include "PtHashCons.h"
 #include "SymStore.h"
-#include <unordered_map>
 
 class SStore; // forward declaration
 
@@ -48,6 +48,17 @@ class PtermIter {
     const PtermIter& operator++ ();// { i++; return *this; }
 };
 
+// Maps the references of the terms that survived a garbage collection to their new references
+class PtRelocation {
+    vec<PTRef> from; // Strictly increasing
+    vec<PTRef> to;
+    friend class PtStore;
+  public:
+    // Returns the new reference of tr, or PTRef_Undef if tr was collected
+    PTRef operator() (PTRef tr) const;
+    int size() const { return from.size(); }
+};
+
 class PtStore {
     PtermAllocator pta{1024*1024};
     SymStore&      symstore;
@@ -56,11 +67,7 @@ class PtStore {
     Map<SymRef,PTRef,SymRefHash,Equal<SymRef> > cterm_map; // Mapping constant symbols to terms
 //    vec<SymRef> cterm_keys;
 
-    std::unordered_map<PTLKey,PTRef,PTLHash,Equal<PTLKey> >    cplx_map;  // Mapping complex terms to canonical terms
-//    vec<PTLKey> cplx_keys;
-
-    std::unordered_map<PTLKey,PTRef,PTLHash,Equal<PTLKey> >    bool_map;  // Mapping boolean terms to canonical terms
-//    vec<PTLKey> bool_keys;
+    PtHashCons cplx_table; // Mapping complex (boolean and other) terms to canonical terms
 //    friend class Logic;
     static const int ptstore_buf_idx;
     static const int ptstore_vec_idx;
@@ -87,16 +94,29 @@ class PtStore {
     }*/
     PTRef getFromCtermMap(SymRef& k);// { return cterm_map[k]; }
 
-    bool hasBoolKey(const PTLKey& k);
-    void addToBoolMap(PTLKey && k, PTRef tr);
-    PTRef getFromBoolMap(const PTLKey& k);
-
-    bool hasCplxKey(const PTLKey& k);
-    void addToCplxMap(PTLKey && k, PTRef tr);
-    PTRef getFromCplxMap(const PTLKey& k);
+    // Returns the canonical term sym(args) or PTRef_Undef if it has not been created yet
+    PTRef lookupCplx(SymRef sym, const vec<PTRef>& args) const;
+    // Creates the canonical term sym(args); the term must not exist yet
+    PTRef newCplxTerm(SymRef sym, const vec<PTRef>& args);
 
     PtermIter getPtermIter();// { return PtermIter(idToPTRef); }
 
+    struct GCStats {
+        uint32_t    liveTerms = 0;
+        uint32_t    collectedTerms = 0;
+        std::size_t reclaimedBytes = 0;
+    };
+
+    /**
+     * Mark-and-compact garbage collection.  The terms not reachable from roots are removed and the surviving
+     * terms are copied to a fresh region.  The ids of the surviving terms do not change, and their references keep
+     * their relative order so that sorted argument lists of commutative terms stay sorted.
+     *
+     * @param roots The live terms, updated in place to their new references
+     * @param reloc Receives the new references of all surviving terms
+     */
+    GCStats garbageCollect(vec<PTRef>& roots, PtRelocation& reloc);
+
     std::size_t getNumberOfTerms() const { return pta.getNumTerms(); }
 };
 
@@ -34,30 +34,8 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "SymRef.h"
 #include "PtStructs.h"
 
+#include <cstring>
 
-// A key used for pterm resolve lookups
-struct PTLKey {
-    SymRef     sym;
-    vec<PTRef> args;
-    friend bool operator== (const PTLKey& k1, const PTLKey& k2) {
-        if (k1.sym != k2.sym) return false;
-        if (k1.args.size() != k2.args.size()) return false;
-        int i;
-        for (i = 0; i < k1.args.size(); i++)
-            if (k1.args[i] != k2.args[i]) break;
-        return i == k1.args.size();
-    }
-};
-
-struct PTLHash {
-    uint32_t operator () (const PTLKey& s) const {
-        uint32_t v = (uint32_t)s.sym.x;
-        for (int i = 0; i < s.args.size(); i++) {
-            v += (uint32_t)s.args[i].x;
-        }
-        return v;
-    }
-};
 
 //typedef uint32_t TRef;
 struct PTId {
@@ -212,7 +190,14 @@ class PtermAllocator : public RegionAllocator<uint32_t>
         return tid;
     }
 
-    PTRef alloc(Pterm&, bool) { assert(false); return PTRef_Undef; }
+    // Copies t, including its id, to this allocator.  Used for relocating terms during garbage collection.
+    PTRef alloc(Pterm const & t)
+    {
+        uint32_t v = RegionAllocator<uint32_t>::alloc(ptermWord32Size(t.size()));
+        PTRef tid = {v};
+        std::memcpy(lea(tid), &t, ptermWord32Size(t.size()) * sizeof(uint32_t));
+        return tid;
+    }
 
     // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
     Pterm&       operator[](PTRef r)         { return (Pterm&)RegionAllocator<uint32_t>::operator[](r.x); }
@@ -227,20 +212,6 @@ class PtermAllocator : public RegionAllocator<uint32_t>
         RegionAllocator<uint32_t>::free(ptermWord32Size(t.size()));
     }
 
-    void reloc(PTRef& tr, PtermAllocator& to);
-    /*{
-        Pterm& t = operator[](tr);
-
-        if (t.reloced()) { tr = t.relocation(); return; }
-
-        tr = to.alloc(t, false);
-        t.relocate(tr);
-
-        // Copy extra data-fields:
-        to[tr].type(t.type());
-//        if (to[tr].learnt())         to[tr].activity() = t.activity();
-//        else if (to[tr].has_extra()) to[tr].calcAbstraction();
-    }*/
     friend class PtStore;
 };
 
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "ClauseExchange.h"
+
+#include <cassert>
+
+ClauseExchange::ClauseExchange(int participants, uint32_t ringCapacity)
+    : mask(ringCapacity - 1)
+    , cursors(participants, std::vector<uint64_t>(participants, 0))
+{
+    assert(participants > 0);
+    assert(ringCapacity > 0 and (ringCapacity & mask) == 0); // Capacity must be a power of two
+    for (int i = 0; i < participants; i++) {
+        rings.emplace_back(new Ring(ringCapacity));
+    }
+}
+
+bool ClauseExchange::publish(int producer, vec<Lit> const & clause)
+{
+    if (clause.size() > maxClauseSize) { return false; }
+    Ring & ring = *rings[producer];
+    uint64_t pos = ring.head.load(std::memory_order_relaxed);
+    Slot & slot = ring.slots[pos & mask];
+
+    slot.seq.store(2 * pos + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.size.store(clause.size(), std::memory_order_relaxed);
+    for (int i = 0; i < clause.size(); i++) {
+        slot.lits[i].store(toInt(clause[i]), std::memory_order_relaxed);
+    }
+    slot.seq.store(2 * pos + 2, std::memory_order_release);
+    ring.head.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+int ClauseExchange::collect(int consumer, vec<Lit> & out)
+{
+    int collected = 0;
+    int lits[maxClauseSize];
+    for (int p = 0; p < participants(); p++) {
+        if (p == consumer) { continue; }
+        Ring const & ring = *rings[p];
+        uint64_t & cursor = cursors[consumer][p];
+        uint64_t head = ring.head.load(std::memory_order_acquire);
+        if (head - cursor > mask + 1) {
+            cursor = head - (mask + 1); // The producer has overwritten the oldest unread clauses
+        }
+        for (; cursor < head; cursor++) {
+            Slot const & slot = ring.slots[cursor & mask];
+            uint64_t const expected = 2 * cursor + 2;
+            if (slot.seq.load(std::memory_order_acquire) != expected) { continue; }
+            uint32_t size = slot.size.load(std::memory_order_relaxed);
+            if (size > maxClauseSize) { continue; }
+            for (uint32_t i = 0; i < size; i++) {
+                lits[i] = slot.lits[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != expected) { continue; } // Overwritten while reading
+            for (uint32_t i = 0; i < size; i++) {
+                out.push(toLit(lits[i]));
+            }
+            out.push(lit_Undef);
+            collected++;
+        }
+    }
+    return collected;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OPENSMT_CLAUSEEXCHANGE_H
+#define OPENSMT_CLAUSEEXCHANGE_H
+
+#include "SolverTypes.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Lock-free broadcast buffer for sharing short learnt clauses between the solvers of a portfolio.
+ *
+ * Every participant owns a single-producer ring of fixed-size slots.  A producer overwrites its
+ * oldest slots without waiting for the consumers; each slot carries a sequence number which acts
+ * as a seqlock, so a consumer that is lapped or that races with the producer detects it and drops
+ * the clause instead of reading a torn one.  Losing a shared clause is harmless since the clauses
+ * are only hints.  Every consumer keeps its own read position for the rings of the other
+ * participants, so publishing and collecting never block each other.
+ */
+class ClauseExchange {
+public:
+    static constexpr int maxClauseSize = 8;  // Longer clauses are not shared
+
+    explicit ClauseExchange(int participants, uint32_t ringCapacity = 4096);
+
+    int participants() const { return static_cast<int>(rings.size()); }
+
+    // Publish a clause learnt by the participant producer.  Returns false if the clause is too long to be shared
+    bool publish(int producer, vec<Lit> const & clause);
+
+    // Appends to out the clauses published by the other participants since the last call of consumer
+    // and returns their number.  The clauses are separated by lit_Undef.
+    int collect(int consumer, vec<Lit> & out);
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq{0};  // 2*(position+1) when the slot holds the clause at position, odd while written
+        std::atomic<uint32_t> size{0};
+        std::atomic<int>      lits[maxClauseSize];
+    };
+
+    struct alignas(64) Ring {
+        explicit Ring(uint32_t capacity) : slots(new Slot[capacity]) {}
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<uint64_t>   head{0};  // Number of clauses ever published to this ring
+    };
+
+    uint32_t const mask;
+    std::vector<std::unique_ptr<Ring>> rings;
+    std::vector<std::vector<uint64_t>> cursors;  // cursors[c][p]: next position of ring p for consumer c
+};
+
+#endif //OPENSMT_CLAUSEEXCHANGE_H
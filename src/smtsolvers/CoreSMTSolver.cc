@@ -45,6 +45,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 **************************************************************************************************/
 
 #include "CoreSMTSolver.h"
+#include "ClauseExchange.h"
 #include "Sort.h"
 #include "ModelBuilder.h"
 
@@ -55,12 +56,6 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "Proof.h"
 
 
-namespace opensmt
-{
-    extern bool stop;
-}
-
-
 //=================================================================================================
 // Constructor/Destructor:
 
@@ -80,6 +75,8 @@ CoreSMTSolver::CoreSMTSolver(SMTConfig & c, THandler& t )
     , rnd_pol          (c.sat_rnd_pol())
     , rnd_init_act     (c.sat_rnd_init_act())
     , garbage_frac     (c.sat_garbage_frac())
+    , lbd_core         (c.sat_lbd_core())
+    , lbd_tier2        (c.sat_lbd_tier2())
     , restart_first    (c.sat_restart_first())
     , restart_inc      (c.sat_restart_inc())
     , learntsize_factor((double)1/(double)3)
@@ -104,6 +101,7 @@ CoreSMTSolver::CoreSMTSolver(SMTConfig & c, THandler& t )
     , cla_inc               (1)
     , var_inc               (1)
     , watches               (WatcherDeleted(ca))
+    , watches_bin           (WatcherDeleted(ca))
     , qhead                 (0)
     , simpDB_assigns        (-1)
     , simpDB_props          (0)
@@ -239,6 +237,8 @@ Var CoreSMTSolver::newVar(bool sign, bool dvar)
     int v = nVars();
     watches  .init(mkLit(v, false));
     watches  .init(mkLit(v, true));
+    watches_bin.init(mkLit(v, false));
+    watches_bin.init(mkLit(v, true));
     assigns  .push(l_Undef);
     vardata  .push(mkVarData(CRef_Undef, 0));
     activity .push(rnd_init_act ? drand(random_seed) * 0.00001 : 0);
@@ -360,8 +360,9 @@ void CoreSMTSolver::attachClause(CRef cr)
 {
     const Clause& c = ca[cr];
     assert(c.size() > 1);
-    watches[~c[0]].push(Watcher(cr, c[1]));
-    watches[~c[1]].push(Watcher(cr, c[0]));
+    auto & ws = c.size() == 2 ? watches_bin : watches;
+    ws[~c[0]].push(Watcher(cr, c[1]));
+    ws[~c[1]].push(Watcher(cr, c[0]));
     if (c.learnt()) learnts_literals += c.size();
     else            clauses_literals += c.size();
 }
@@ -370,16 +371,17 @@ void CoreSMTSolver::detachClause(CRef cr, bool strict)
 {
     const Clause& c = ca[cr];
     assert(c.size() > 1);
+    auto & ws = c.size() == 2 ? watches_bin : watches;
     if (strict)
     {
-        remove(watches[~c[0]], Watcher(cr, c[1]));
-        remove(watches[~c[1]], Watcher(cr, c[0]));
+        remove(ws[~c[0]], Watcher(cr, c[1]));
+        remove(ws[~c[1]], Watcher(cr, c[0]));
     }
     else
     {
         // Lazy detaching: (NOTE! Must clean all watcher lists before garbage collecting this clause)
-        watches.smudge(~c[0]);
-        watches.smudge(~c[1]);
+        ws.smudge(~c[0]);
+        ws.smudge(~c[1]);
     }
 
     if (c.learnt()) learnts_literals -= c.size();
@@ -391,7 +393,7 @@ void CoreSMTSolver::removeClause(CRef cr)
     Clause& c = ca[cr];
     detachClause(cr);
     // Don't leave pointers to free'd memory!
-    if (locked(c)) vardata[var(c[0])].reason = CRef_Undef;
+    if (locked(c)) vardata[var(impliedLit(c))].reason = CRef_Undef;
     c.mark(1);
     if (logsProofForInterpolation()) {
         // Remove clause and derivations if ref becomes 0
@@ -685,7 +687,7 @@ Lit CoreSMTSolver::pickBranchLit()
   |    Will undo part of the trail, upto but not beyond the assumption of the current decision level.
   |________________________________________________________________________________________________@*/
 
-void CoreSMTSolver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
+void CoreSMTSolver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel, unsigned& out_lbd)
 {
     bool logsProofForInterpolation = this->logsProofForInterpolation();
     assert(!logsProofForInterpolation || !proof->hasOpenChain());
@@ -710,9 +712,20 @@ void CoreSMTSolver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
     {
         assert(confl != CRef_Undef); // (otherwise should be UIP)
         Clause& c = ca[confl];
+        // Binary reasons are not reordered by propagation
+        if (p != lit_Undef && c.size() == 2 && c[0] != p)
+            std::swap(c[0], c[1]);
 
         if (c.learnt()) {
             claBumpActivity(c);
+            // The clause is in use; its literals are all assigned now, so its LBD may have improved since it was learnt
+            c.used(true);
+            if (c.tier() != Clause::tier_core) {
+                unsigned lbd = computeLBD(c);
+                if (lbd < c.lbd()) {
+                    setLBD(c, lbd);
+                }
+            }
         }
 
         for (unsigned j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++)
@@ -890,6 +903,7 @@ void CoreSMTSolver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
         out_learnt[1]     = p;
         out_btlevel       = level(var(p));
     }
+    out_lbd = computeLBD(out_learnt);
 
 #ifdef REPORT_DL1_THLITS
     if (out_learnt.size() == 1)
@@ -981,6 +995,8 @@ bool CoreSMTSolver::litRedundant(Lit p, uint32_t abstract_levels)
         }
 
         Clause& c = ca[cr];
+        if (c.size() == 2 && var(c[0]) != var(analyze_stack.last()))
+            std::swap(c[0], c[1]);
 
         analyze_stack.pop();
 
@@ -1089,6 +1105,8 @@ void CoreSMTSolver::analyzeFinal(Lit p, vec<Lit>& out_conflict)
                 else
                 {
                     Clause& c = ca[reason(x)];
+                    if (c.size() == 2 && c[0] != trail[i])
+                        std::swap(c[0], c[1]);
                     assert(c[0] == trail[i]);
                     for (unsigned j = 1; j < c.size(); j++) {
                         seen[var(c[j])] = 1;
@@ -1126,6 +1144,29 @@ void CoreSMTSolver::uncheckedEnqueue(Lit p, CRef from)
 }
 
 
+CRef CoreSMTSolver::deriveUnitAtRoot(CRef cr, Lit p)
+{
+    // MB: we need to log the derivation of the unit clauses at level 0, otherwise the proof
+    //     is not constructed correctly
+    assert(decisionLevel() == 0 && logsProofForInterpolation());
+    proof->beginChain(cr);
+    Clause const & c = ca[cr];
+    for (unsigned k = 0; k < c.size(); k++)
+    {
+        if (c[k] == p) continue;
+        assert(level(var(c[k])) == 0);
+        assert(reason(var(c[k])) != CRef_Fake);
+        assert(reason(var(c[k])) != CRef_Undef);
+        proof->addResolutionStep(reason(var(c[k])), var(c[k]));
+    }
+    CRef unitClause = ca.alloc(vec<Lit>{p});
+    proof->endChain(unitClause);
+    // Replace the reason for enqueing the literal with the unit clause.
+    // Necessary for correct functioning of proof logging in analyze()
+    return unitClause;
+}
+
+
 /*_________________________________________________________________________________________________
   |
   |  propagate : [void]  ->  [Clause*]
@@ -1142,13 +1183,40 @@ CRef CoreSMTSolver::propagate()
     CRef    confl     = CRef_Undef;
     int     num_props = 0;
     watches.cleanAll();
+    watches_bin.cleanAll();
 
     while (qhead < trail.size())
     {
         Lit            p   = trail[qhead++];     // 'p' is enqueued fact to propagate.
+        num_props++;
+
+        // Binary clauses first; the other literal is in the watcher, so the clause is not inspected:
+        vec<Watcher>&  ws_bin = watches_bin[p];
+        for (int k = 0; k < ws_bin.size(); k++)
+        {
+            Lit other = ws_bin[k].blocker;
+            if (value(other) == l_True)
+                continue;
+            CRef cr = ws_bin[k].cref;
+            if (value(other) == l_False) // clause is falsified
+            {
+                confl = cr;
+                qhead = trail.size();
+                if (decisionLevel() == 0 && this->logsProofForInterpolation()) {
+                    this->finalizeProof(confl);
+                }
+                break;
+            }
+            if (decisionLevel() == 0 && this->logsProofForInterpolation()) {
+                cr = deriveUnitAtRoot(cr, other);
+            }
+            uncheckedEnqueue(other, cr);
+        }
+        if (confl != CRef_Undef)
+            break;
+
         vec<Watcher>&  ws  = watches[p];
         Watcher        *i, *j, *end;
-        num_props++;
 
         for (i = j = (Watcher*)ws, end = i + ws.size();  i != end;)
         {
@@ -1205,21 +1273,7 @@ CRef CoreSMTSolver::propagate()
             }
             else {  // clause is unit under assignment:
                 if (decisionLevel() == 0 && this->logsProofForInterpolation()) {
-                    // MB: we need to log the derivation of the unit clauses at level 0, otherwise the proof
-                    //     is not constructed correctly
-                    proof->beginChain(cr);
-                    for (unsigned k = 1; k < c.size(); k++)
-                    {
-                        assert(level(var(c[k])) == 0);
-                        assert(reason(var(c[k])) != CRef_Fake);
-                        assert(reason(var(c[k])) != CRef_Undef);
-                        proof->addResolutionStep(reason(var(c[k])), var(c[k]));
-                    }
-                    CRef unitClause = ca.alloc(vec<Lit>{first});
-                    proof->endChain(unitClause);
-                    // Replace the reason for enqueing the literal with the unit clause.
-                    // Necessary for correct functioning of proof logging in analyze()
-                    cr = unitClause;
+                    cr = deriveUnitAtRoot(cr, first);
                 }
                 uncheckedEnqueue(first, cr);
             }
@@ -1241,8 +1295,12 @@ NextClause:
   |  reduceDB : ()  ->  [void]
   |
   |  Description:
-  |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
-  |    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+  |    Learnt clauses are kept in three tiers by their literal block distance (LBD). Clauses of the
+  |    core tier are never removed. Clauses of the middle tier stay while they take part in conflicts;
+  |    the ones not used since the last reduction are moved to the local tier. Of the local tier, remove
+  |    half of the clauses, the ones with the highest LBD and lowest activity first, minus the clauses
+  |    locked by the current assignment. Locked clauses are clauses that are reason to some assignment.
+  |    Binary clauses are never removed.
   |________________________________________________________________________________________________@*/
 struct reduceDB_lt
 {
@@ -1250,7 +1308,15 @@ struct reduceDB_lt
     reduceDB_lt(ClauseAllocator& ca_) : ca(ca_) {}
     bool operator () (CRef x, CRef y)
     {
-        return ca[x].size() > 2 && (ca[y].size() == 2 || ca[x].activity() < ca[y].activity());
+        // The local clauses come first, the worst ones first
+        Clause & cx = ca[x];
+        Clause & cy = ca[y];
+        bool xLocal = cx.tier() == Clause::tier_local && cx.size() > 2;
+        bool yLocal = cy.tier() == Clause::tier_local && cy.size() > 2;
+        if (xLocal != yLocal) return xLocal;
+        if (!xLocal) return false;
+        if (cx.lbd() != cy.lbd()) return cx.lbd() > cy.lbd();
+        return cx.activity() < cy.activity();
     }
 };
 void CoreSMTSolver::reduceDB()
@@ -1258,13 +1324,24 @@ void CoreSMTSolver::reduceDB()
     int     i, j;
     double  extra_lim = cla_inc / learnts.size();    // Remove any clause below this activity
 
+    int localCount = 0;
+    core_learnts = 0;
+    for (CRef cr : learnts) {
+        Clause& c = ca[cr];
+        if (c.tier() == Clause::tier_mid && !c.used())
+            c.tier(Clause::tier_local);
+        c.used(false);
+        core_learnts += c.tier() == Clause::tier_core;
+        localCount += c.tier() == Clause::tier_local && c.size() > 2;
+    }
+
     sort(learnts, reduceDB_lt(ca));
-    // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
+    // Don't delete binary or locked clauses. From the local ones, delete clauses from the first half
     // and clauses with activity smaller than 'extra_lim':
     for (i = j = 0; i < learnts.size(); i++)
     {
         Clause& c = ca[learnts[i]];
-        if (c.size() > 2 && !locked(c) && (i < learnts.size() / 2 || c.activity() < extra_lim))
+        if (i < localCount && !locked(c) && (i < localCount / 2 || c.activity() < extra_lim))
             removeClause(learnts[i]);
         else
             learnts[j++] = learnts[i];
@@ -1399,6 +1476,8 @@ void CoreSMTSolver::popBacktrackPoint()
             assigns     .pop();
             watches.clean(mkLit(x, true));
             watches.clean(mkLit(x, false));
+            watches_bin.clean(mkLit(x, true));
+            watches_bin.clean(mkLit(x, false));
             // Remove variable from translation tables
 //      theory_handler->clearVar( x );
         }
@@ -1441,17 +1520,12 @@ void CoreSMTSolver::popBacktrackPoint()
 
 bool CoreSMTSolver::okContinue()
 {
-    // Added line
-    if ( opensmt::stop ) return false;
-
-    if (conflicts % 1000 == 0) {
-        if ( this->stop )
-            return false;
-    }
+    if (this->stop.load(std::memory_order_relaxed))
+        return false;
     if (resource_limit >= 0 && conflicts % 1000 == 0) {
         if ((resource_units == spm_time && time(NULL) >= next_resource_limit) ||
             (resource_units == spm_decisions && decisions >= next_resource_limit)) {
-            opensmt::stop = true;
+            this->stop = true;
             return false;
         }
     }
@@ -1550,6 +1624,8 @@ lbool CoreSMTSolver::search(int nof_conflicts, int nof_learnts)
         if (!okContinue())
             return l_Undef;
         runPeriodics();
+        if (clause_exchange != nullptr && decisionLevel() == 0 && !importSharedClauses())
+            return zeroLevelConflictHandler();
 
 
         CRef confl = propagate();
@@ -1563,11 +1639,14 @@ lbool CoreSMTSolver::search(int nof_conflicts, int nof_learnts)
                 return zeroLevelConflictHandler();
             }
             learnt_clause.clear();
-            analyze(confl, learnt_clause, backtrack_level);
+            unsigned lbd;
+            analyze(confl, learnt_clause, backtrack_level, lbd);
 
             cancelUntil(backtrack_level);
 
             assert(value(learnt_clause[0]) == l_Undef);
+            if (clause_exchange != nullptr)
+                clause_exchange->publish(exchange_id, learnt_clause);
 
             if (learnt_clause.size() == 1)
             {
@@ -1587,6 +1666,7 @@ lbool CoreSMTSolver::search(int nof_conflicts, int nof_learnts)
                 all_learnts ++;
 
                 CRef cr = ca.alloc(learnt_clause, true);
+                setLBD(ca[cr], lbd);
 
                 if (logsProofForInterpolation()) {
                     proof->endChain(cr);
@@ -1621,7 +1701,7 @@ lbool CoreSMTSolver::search(int nof_conflicts, int nof_learnts)
             // Two ways of reducing the clause.  The latter one seems to be working
             // better (not running proper tests since the cluster is down...)
             // if ((learnts.size()-nAssigns()) >= max_learnts)
-            if (nof_learnts >= 0 && learnts.size()-nAssigns() >= nof_learnts)
+            if (nof_learnts >= 0 && learnts.size()-nAssigns()-core_learnts >= nof_learnts)
                 // Reduce the set of learnt clauses:
                 reduceDB();
 
@@ -1691,7 +1771,7 @@ lbool CoreSMTSolver::search(int nof_conflicts, int nof_learnts)
                 {
                     if (!createSplit_scatter())   // Rest is unsat
                     {
-                        opensmt::stop = true;
+                        this->stop = true;
                         return l_Undef;
                     }
                     else continue;
@@ -1752,7 +1832,7 @@ lbool CoreSMTSolver::search(int nof_conflicts, int nof_learnts)
     }
     cancelUntil(0);
     createSplit_scatter();
-    opensmt::stop = true;
+    this->stop = true;
     return l_Undef;
 }
 
@@ -1932,7 +2012,7 @@ lbool CoreSMTSolver::solve_()
 
     if (config.dryrun())
         stop = true;
-    while (status == l_Undef && !opensmt::stop && !this->stop)
+    while (status == l_Undef && !this->stop && withinBudget())
     {
         // Print some information. At every restart for
         // standard mode or any 2^n intervarls for luby
@@ -1978,7 +2058,7 @@ lbool CoreSMTSolver::solve_()
     }
     else
     {
-        assert( opensmt::stop || status == l_False || this->stop);
+        assert(status == l_False || this->stop || !withinBudget());
     }
 
     // We terminate
@@ -1993,10 +2073,76 @@ void CoreSMTSolver::clearSearch()
 //    }
 }
 
+void CoreSMTSolver::exportProblem(vec<Lit> & out) const
+{
+    int const units = trail_lim.size() == 0 ? trail.size() : trail_lim[0];
+    for (int i = 0; i < units; i++) {
+        out.push(trail[i]);
+        out.push(lit_Undef);
+    }
+    for (CRef cr : clauses) {
+        Clause const & c = ca[cr];
+        for (unsigned j = 0; j < c.size(); j++)
+            out.push(c[j]);
+        out.push(lit_Undef);
+    }
+}
+
+Var CoreSMTSolver::pickCubeExtension(vec<Lit> const & cube)
+{
+    Var best = var_Undef;
+    for (Var v = 0; v < nVars(); v++) {
+        if (!decision[v] || value(v) != l_Undef || (best != var_Undef && activity[v] <= activity[best]))
+            continue;
+        if (std::any_of(cube.begin(), cube.end(), [v](Lit l) { return var(l) == v; }))
+            continue;
+        if (!theory_handler.getTheory().okToPartition(theory_handler.varToTerm(v)))
+            continue;
+        best = v;
+    }
+    return best;
+}
+
+bool CoreSMTSolver::importSharedClauses()
+{
+    assert(decisionLevel() == 0);
+    assert(not logsProofForInterpolation());
+    shared_clauses.clear();
+    if (clause_exchange->collect(exchange_id, shared_clauses) == 0)
+        return true;
+
+    vec<Lit> c;
+    bool skip = false;
+    for (Lit l : shared_clauses) {
+        if (l != lit_Undef) {
+            // Simplify the clause with respect to the level-0 assignment
+            if (var(l) >= nVars() || !decision[var(l)] || value(l) == l_True)
+                skip = true;
+            else if (value(l) == l_Undef)
+                c.push(l);
+            continue;
+        }
+        if (!skip) {
+            if (c.size() == 0) {
+                return false;
+            } else if (c.size() == 1) {
+                uncheckedEnqueue(c[0]);
+            } else {
+                CRef cr = ca.alloc(c, true);
+                learnts.push(cr);
+                attachClause(cr);
+            }
+        }
+        c.clear();
+        skip = false;
+    }
+    return true;
+}
+
 lbool CoreSMTSolver::zeroLevelConflictHandler() {
     if (splits.size() > 0)
     {
-        opensmt::stop = true;
+        this->stop = true;
         return l_Undef;
     }
     else {
@@ -2015,6 +2161,7 @@ void CoreSMTSolver::relocAll(ClauseAllocator& to)
     //
     // for (int i = 0; i < watches.size(); i++)
     watches.cleanAll();
+    watches_bin.cleanAll();
     for (int v = 0; v < nVars(); v++)
         for (int s = 0; s < 2; s++)
         {
@@ -2023,6 +2170,9 @@ void CoreSMTSolver::relocAll(ClauseAllocator& to)
             vec<Watcher>& ws = watches[p];
             for (int j = 0; j < ws.size(); j++)
                 ca.reloc(ws[j].cref, to);
+            vec<Watcher>& ws_bin = watches_bin[p];
+            for (int j = 0; j < ws_bin.size(); j++)
+                ca.reloc(ws_bin[j].cref, to);
         }
 
     // All reasons:
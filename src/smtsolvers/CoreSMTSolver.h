@@ -51,6 +51,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "SMTSolver.h"
 #include "THandler.h"
 
+#include <atomic>
 #include <cstdio>
 #include <iosfwd>
 #include <memory>
@@ -68,6 +69,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 class Proof;
 class ModelBuilder;
+class ClauseExchange;
 
 // Helper method to print Literal to a stream
 std::ostream& operator <<(std::ostream& out, Lit l); // MB: Feel free to find a better place for this method.
@@ -77,7 +79,7 @@ std::ostream& operator <<(std::ostream& out, Lit l); // MB: Feel free to find a
 //
 class SplitData
 {
-    bool                no_instance;    // Does SplitData store the instance?
+    bool                no_instance;    // Was only the split requested?  The instance itself is written by MainSolver
 
     std::vector<vec<Lit>>      constraints;    // The split constraints
     std::vector<vec<Lit>>      learnts;        // The learnt clauses
@@ -91,7 +93,7 @@ class SplitData
 public:
     SplitData(bool no_instance = true)
         : no_instance(no_instance)
-    { assert(no_instance); }
+    {}
 
     template<class C> void addConstraint(const C& c)
     {
@@ -109,6 +111,7 @@ public:
     }
 
     char* splitToString();
+    bool  getCube(vec<Lit> & out) const; // If all constraints are unit clauses, writes their literals to out and returns true
     inline void  constraintsToPTRefs(std::vector<vec<PtAsgn>>& out, const THandler& thandler) const { toPTRefs(out, constraints, thandler); }
     inline void  learntsToPTRefs(std::vector<vec<PtAsgn>>& out, const THandler& thandler) const { toPTRefs(out, learnts, thandler); }
 };
@@ -200,6 +203,17 @@ inline char* SplitData::splitToString()
     return buf;
 }
 
+inline bool SplitData::getCube(vec<Lit> & out) const
+{
+    out.clear();
+    for (const vec<Lit>& c : constraints) {
+        if (c.size() != 1)
+            return false;
+        out.push(c[0]);
+    }
+    return true;
+}
+
 inline void SplitData::toPTRefs(std::vector<vec<PtAsgn> >& out, const std::vector<vec<Lit> >& in, const THandler& theory_handler) const
 {
     for (const vec<Lit>& c : in) {
@@ -232,7 +246,7 @@ protected:
     bool      verbosity;
     bool      init;
 public:
-    bool stop = false;
+    std::atomic<bool> stop;     // Can be set from another thread to make the search return l_Undef
 
     // Constructor/Destructor:
     //
@@ -319,6 +333,14 @@ public:
     inline void restoreOK          ( )       { ok = true; conflict_frame = 0; }
     inline bool isOK               ( ) const { return ok; } // FALSE means solver is in a conflicting state
     inline int  getConflictFrame   ( ) const { assert(not isOK()); return conflict_frame; }
+    inline void setConflicting     (int frame) { ok = false; conflict_frame = frame; } // Adopt a conflict found by another solver for the same problem
+
+    // Parallel solving:
+    //
+    void    exportProblem      (vec<Lit> & out) const; // Appends the level-0 units and the problem clauses, each terminated by lit_Undef
+    void    setClauseExchange  (ClauseExchange * exchange, int id) { clause_exchange = exchange; exchange_id = id; }
+    bool    isDecisionVar      (Var v) const { return decision[v]; }
+    Var     pickCubeExtension  (vec<Lit> const & cube); // The most active unassigned variable, not in cube, that the theory allows splitting on
 
     template<class C>
     void     printSMTClause   ( ostream &, const C& );
@@ -345,6 +367,8 @@ public:
     bool      rnd_pol;            // Use random polarities for branching heuristics.
     bool      rnd_init_act;       // Initialize variable activities with a small random value.
     double    garbage_frac;       // The fraction of wasted memory allowed before a garbage collection is triggered.
+    unsigned  lbd_core;           // Learnt clauses with at most this LBD are never removed.                                   (default 2)
+    unsigned  lbd_tier2;          // Learnt clauses with at most this LBD are kept while they take part in conflicts.         (default 6)
     int       restart_first;      // The initial restart limit.                                                                (default 100)
     double    restart_inc;        // The factor with which the restart limit is multiplied in each restart.                    (default 1.1)
     double    learntsize_factor;  // The intitial limit for learnt clauses is a factor of the original clauses.                (default 1 / 3)
@@ -463,6 +487,7 @@ protected:
     vec<double>         activity;         // A heuristic measurement of the activity of a variable.
     double              var_inc;          // Amount to bump next variable with.
     OccLists<Lit, vec<Watcher>, WatcherDeleted>  watches;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    OccLists<Lit, vec<Watcher>, WatcherDeleted>  watches_bin;      // 'watches_bin[lit]' is a list of binary clauses watching 'lit'; the blocker is the other literal of the clause.
     vec<lbool>          assigns;          // The current assignments (lbool:s stored as char:s).
     vec<bool>           var_seen;
     vec<char>           polarity;         // The preferred polarity of each variable.
@@ -501,6 +526,9 @@ protected:
     vec<Lit>            analyze_stack;
     vec<Lit>            analyze_toclear;
     vec<Lit>            add_tmp;
+    vec<uint64_t>       lbd_stamps;       // 'lbd_stamps[level]' is 'lbd_stamp' if the level was counted in the current LBD computation.
+    uint64_t            lbd_stamp = 0;
+    int                 core_learnts = 0; // Number of learnt clauses in the core tier at the last 'reduceDB()'.
 
     double              max_learnts;
     double              learntsize_adjust_confl;
@@ -545,8 +573,9 @@ protected:
     void     uncheckedEnqueue (Lit p, CRef from = CRef_Undef);                         // Enqueue a literal. Assumes value of literal is undefined.
     bool     enqueue          (Lit p, CRef from = CRef_Undef);                         // Test if fact 'p' contradicts current state, enqueue otherwise.
     CRef     propagate        ();                                                      // Perform unit propagation. Returns possibly conflicting clause.
+    CRef     deriveUnitAtRoot (CRef cr, Lit p);                                        // Log the derivation of unit 'p' from clause 'cr' at level 0 and return the unit clause.
     virtual void cancelUntil  (int level);                                             // Backtrack until a certain level.
-    void     analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel);    // (bt = backtrack)
+    void     analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel, unsigned& out_lbd); // (bt = backtrack)
     void     analyzeFinal     (Lit p, vec<Lit>& out_conflict);                         // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
     bool     litRedundant     (Lit p, uint32_t abstract_levels);                       // (helper method for 'analyze()')
     lbool    search           (int nof_conflicts, int nof_learnts);                    // Search for a given number of conflicts.
@@ -568,6 +597,9 @@ protected:
 //    void     boolVarDecActivity( );                    // Decrease boolean atoms activity
     void     claDecayActivity  ( );                    // Decay all clauses with the specified factor. Implemented by increasing the 'bump' value instead.
     void     claBumpActivity   ( Clause & c );         // Increase a clause with the current 'bump' value.
+    template<class Lits>
+    unsigned computeLBD        ( const Lits & lits );  // Number of distinct decision levels of the literals; each unassigned literal counts as a level of its own.
+    void     setLBD            ( Clause & c, unsigned lbd ); // Store the LBD of a learnt clause and move it to the tier the LBD qualifies for.
     // Increase a clause with the current 'bump' value.
 
 
@@ -577,6 +609,7 @@ protected:
     virtual void detachClause     (CRef cr, bool strict = false); // Detach a clause to watcher lists.
     void     removeClause     (CRef c);             // Detach and free a clause.
     bool     locked           (const Clause& c) const; // Returns TRUE if a clause is a reason for some implication in the current state.
+    Lit      impliedLit       (const Clause& c) const; // The literal a clause implies if it is a reason, i.e., the first one except for some binary clauses.
     bool     satisfied        (const Clause& c) const; // Returns TRUE if a clause is satisfied in the current state.
 
     void     relocAll         (ClauseAllocator& to);
@@ -755,6 +788,11 @@ protected:
     virtual inline void clausesPublish() {};
     virtual inline void clausesUpdate() {};
 
+    ClauseExchange *    clause_exchange = nullptr; // Shares learnt clauses with the other solvers of a portfolio, if set
+    int                 exchange_id = 0;           // The index of this solver in clause_exchange
+    vec<Lit>            shared_clauses;            // Buffer for the clauses received from clause_exchange
+    bool                importSharedClauses();     // Adds the clauses learnt by the other solvers at level 0.  Returns false on conflict
+
     using SplitClauses = std::vector<vec<Lit>>;
     TPropRes handleNewSplitClauses(SplitClauses & clauses);
 };
@@ -827,6 +865,36 @@ inline void CoreSMTSolver::claBumpActivity (Clause& c)
     }
 }
 
+template<class Lits>
+inline unsigned CoreSMTSolver::computeLBD(const Lits & lits)
+{
+    if (lbd_stamps.size() <= decisionLevel())
+        lbd_stamps.growTo(decisionLevel() + 1, 0);
+    ++lbd_stamp;
+    unsigned lbd = 0;
+    for (int i = 0; i < static_cast<int>(lits.size()); i++) {
+        Var x = var(lits[i]);
+        if (value(x) == l_Undef) {
+            ++lbd;
+            continue;
+        }
+        int l = level(x);
+        if (lbd_stamps[l] != lbd_stamp) {
+            lbd_stamps[l] = lbd_stamp;
+            ++lbd;
+        }
+    }
+    return lbd;
+}
+inline void CoreSMTSolver::setLBD(Clause & c, unsigned lbd)
+{
+    assert(c.learnt());
+    c.lbd(lbd);
+    uint32_t tier = lbd <= lbd_core ? Clause::tier_core : lbd <= lbd_tier2 ? Clause::tier_mid : Clause::tier_local;
+    if (tier < c.tier())
+        c.tier(tier);
+}
+
 inline void CoreSMTSolver::checkGarbage(void) { return checkGarbage(garbage_frac); }
 inline void CoreSMTSolver::checkGarbage(double gf)
 {
@@ -875,9 +943,15 @@ inline bool     CoreSMTSolver::addOriginalClause(Lit p, Lit q, Lit r)
 
 
 
+inline Lit      CoreSMTSolver::impliedLit      (const Clause& c) const
+{
+    // Binary clauses are propagated without reordering them, the implied literal may be the second one
+    return c.size() == 2 && value(c[0]) != l_True ? c[1] : c[0];
+}
 inline bool     CoreSMTSolver::locked          (const Clause& c) const
 {
-    return value(c[0]) == l_True && reason(var(c[0])) != CRef_Undef && reason(var(c[0])) != CRef_Fake && ca.lea(reason(var(c[0]))) == &c;
+    Lit p = impliedLit(c);
+    return value(p) == l_True && reason(var(p)) != CRef_Undef && reason(var(p)) != CRef_Fake && ca.lea(reason(var(p))) == &c;
 }
 #ifndef PEDANTIC_DEBUG
 inline void     CoreSMTSolver::newDecisionLevel()
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "CubeQueue.h"
+
+#include <cassert>
+
+CubeQueue::CubeQueue(int workers)
+{
+    assert(workers > 0);
+    for (int i = 0; i < workers; i++) {
+        deques.emplace_back(new Deque());
+    }
+}
+
+void CubeQueue::push(int worker, vec<Lit> && cube)
+{
+    {
+        std::lock_guard<std::mutex> lock(deques[worker]->mtx);
+        deques[worker]->cubes.push_back(std::move(cube));
+    }
+    pending++;
+    queued++;
+    wakeUp(false);
+}
+
+bool CubeQueue::take(int worker, vec<Lit> & cube)
+{
+    Deque & own = *deques[worker];
+    std::lock_guard<std::mutex> lock(own.mtx);
+    if (own.cubes.empty()) { return false; }
+    cube = std::move(own.cubes.back());
+    own.cubes.pop_back();
+    queued--;
+    return true;
+}
+
+bool CubeQueue::steal(int worker, vec<Lit> & cube)
+{
+    for (int i = 1; i < workers(); i++) {
+        Deque & victim = *deques[(worker + i) % workers()];
+        std::lock_guard<std::mutex> lock(victim.mtx);
+        if (victim.cubes.empty()) { continue; }
+        cube = std::move(victim.cubes.front());
+        victim.cubes.pop_front();
+        queued--;
+        return true;
+    }
+    return false;
+}
+
+bool CubeQueue::pop(int worker, vec<Lit> & cube)
+{
+    while (not isCancelled()) {
+        if (take(worker, cube) or steal(worker, cube)) {
+            return true;
+        }
+        std::unique_lock<std::mutex> lock(idle_mtx);
+        idle++;
+        idle_cv.wait(lock, [this]() { return isCancelled() or pending == 0 or queued > 0; });
+        idle--;
+        if (pending == 0) { return false; }
+    }
+    return false;
+}
+
+void CubeQueue::done()
+{
+    if (--pending == 0) {
+        wakeUp(true);
+    }
+}
+
+void CubeQueue::cancel()
+{
+    cancelled = true;
+    wakeUp(true);
+}
+
+void CubeQueue::wakeUp(bool all)
+{
+    // Taking the lock orders the update of the counters before the check of a worker about to wait
+    { std::lock_guard<std::mutex> lock(idle_mtx); }
+    if (all) {
+        idle_cv.notify_all();
+    } else {
+        idle_cv.notify_one();
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OPENSMT_CUBEQUEUE_H
+#define OPENSMT_CUBEQUEUE_H
+
+#include "SolverTypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Work-stealing queue of cubes for the conquer phase of cube-and-conquer.
+ *
+ * Every worker owns a deque.  A worker takes the most recently pushed cube from its own deque, and
+ * when the deque is empty it steals the oldest cube of another worker, which is likely to be the
+ * largest remaining part of the search space.  A cube is pending from the moment it is pushed
+ * until the worker that took it calls done(); the workers that find no cube sleep until either new
+ * cubes are pushed or no cube is pending anymore.
+ */
+class CubeQueue {
+public:
+    explicit CubeQueue(int workers);
+
+    int workers() const { return static_cast<int>(deques.size()); }
+
+    // Adds a cube to the deque of worker
+    void push(int worker, vec<Lit> && cube);
+
+    // Takes a cube for worker, waiting if necessary.  Returns false when all cubes are done or the queue is cancelled
+    bool pop(int worker, vec<Lit> & cube);
+
+    // Marks the cube taken by the last pop of the caller as finished.  Cubes pushed before calling done() keep the queue alive
+    void done();
+
+    // Wakes up all workers and makes pop return false from now on
+    void cancel();
+
+    bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+    // True if some worker is waiting for a cube
+    bool hasIdleWorkers() const { return idle.load(std::memory_order_relaxed) > 0; }
+
+private:
+    struct Deque {
+        std::mutex mtx;
+        std::deque<vec<Lit>> cubes;
+    };
+
+    bool take(int worker, vec<Lit> & cube);
+    bool steal(int worker, vec<Lit> & cube);
+    void wakeUp(bool all);
+
+    std::vector<std::unique_ptr<Deque>> deques;
+    std::atomic<int>  pending{0};  // Cubes pushed but not done
+    std::atomic<int>  queued{0};   // Cubes pushed but not taken
+    std::atomic<int>  idle{0};
+    std::atomic<bool> cancelled{false};
+    std::mutex idle_mtx;
+    std::condition_variable idle_cv;
+};
+
+#endif //OPENSMT_CUBEQUEUE_H
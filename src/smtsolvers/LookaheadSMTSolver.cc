@@ -84,7 +84,8 @@ lbool LookaheadSMTSolver::laPropagateWrapper() {
 
             vec<Lit> out_learnt;
             int out_btlevel;
-            analyze(cr, out_learnt, out_btlevel);
+            unsigned out_lbd;
+            analyze(cr, out_learnt, out_btlevel, out_lbd);
 #ifdef LADEBUG
             printf("Conflict: I would need to backtrack from %d to %d\n", decisionLevel(), out_btlevel);
 #endif
@@ -94,6 +95,7 @@ lbool LookaheadSMTSolver::laPropagateWrapper() {
                 uncheckedEnqueue(out_learnt[0]);
             } else {
                 CRef crd = ca.alloc(out_learnt, true);
+                setLBD(ca[crd], out_lbd);
                 learnts.push(crd);
                 attachClause(crd);
                 uncheckedEnqueue(out_learnt[0], crd);
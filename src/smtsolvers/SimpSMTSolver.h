@@ -81,6 +81,7 @@ public:
     lbool    solve       (Lit p       ,        bool do_simp = true, bool turn_off_simp = false);
     lbool    solve       (Lit p, Lit q,        bool do_simp = true, bool turn_off_simp = false);
     lbool    solve       (Lit p, Lit q, Lit r, bool do_simp = true, bool turn_off_simp = false);
+    lbool    solveCDCL   (const vec<Lit>& assumps); // Solve without simplification by CDCL, also if a subclass replaces the search
     bool    eliminate   (bool turn_off_elim = false);  // Perform variable elimination based simplification. 
 
     // Memory managment:
@@ -201,6 +202,8 @@ inline lbool SimpSMTSolver::solve        (const vec<Lit>& assumps, bool do_simp,
     budgetOff(); setAssumptions(assumps); return solve_(do_simp, turn_off_simp); }
 inline lbool SimpSMTSolver::solveLimited (const vec<Lit>& assumps, bool do_simp, bool turn_off_simp){
     setAssumptions(assumps); return solve_(do_simp, turn_off_simp); }
+inline lbool SimpSMTSolver::solveCDCL    (const vec<Lit>& assumps) {
+    budgetOff(); setAssumptions(assumps); lbool res = CoreSMTSolver::solve_(); if (res == l_True) { extendModel(); } return res; }
 //inline bool CoreSMTSolver::smtSolve     () { return solve(); }
 
 //=================================================================================================
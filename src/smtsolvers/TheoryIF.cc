@@ -171,6 +171,10 @@ TPropRes CoreSMTSolver::handleNewSplitClauses(SplitClauses & splitClauses) {
             propData.push_back(PropagationData{.lit = implied, .reason = cr});
             res = TPropRes::Propagate;
         } else {
+            if (satisfied == 0) {
+                // Watch and split on the unassigned literals, the clause can contain literals that are already false
+                std::stable_partition(splitClause.begin(), splitClause.end(), [this](Lit l) { return value(l) == l_Undef; });
+            }
             processNewClause(splitClause);
             if (satisfied == 0) {
                 forced_split = ~splitClause[0];
@@ -288,6 +292,8 @@ CoreSMTSolver::handleUnsat()
     else
     {
         confl = ca.alloc(conflicting, config.sat_temporary_learn);
+        if (ca[confl].learnt())
+            setLBD(ca[confl], computeLBD(conflicting));
         learnts.push(confl);
         attachClause(confl);
         claBumpActivity(ca[confl]);
@@ -301,7 +307,8 @@ CoreSMTSolver::handleUnsat()
     if (logsProofForInterpolation()) {
         proof->newTheoryClause(confl);
     }
-    analyze( confl, learnt_clause, backtrack_level );
+    unsigned lbd;
+    analyze( confl, learnt_clause, backtrack_level, lbd );
 
     if (!logsProofForInterpolation()) {
         // Get rid of the temporary lemma
@@ -329,6 +336,7 @@ CoreSMTSolver::handleUnsat()
         all_learnts ++;
 
         CRef cr = ca.alloc(learnt_clause, true);
+        setLBD(ca[cr], lbd);
 
         if (logsProofForInterpolation()) {
             proof->endChain(cr);
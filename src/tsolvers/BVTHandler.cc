@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "BVTHandler.h"
+
+BVTHandler::BVTHandler(SMTConfig & c, BVLogic & l)
+    : UFTHandler(c, l)
+    , logic(l)
+    , bitBlaster(l)
+{}
+
+BVTHandler::~BVTHandler()
+{}
+
+BVLogic&
+BVTHandler::getLogic()
+{
+    return logic;
+}
+
+const BVLogic&
+BVTHandler::getLogic() const
+{
+    return logic;
+}
+
+void BVTHandler::fillTheoryFunctions(ModelBuilder & modelBuilder) const
+{
+    UFTHandler::fillTheoryFunctions(modelBuilder);
+    bitBlaster.fillModel(modelBuilder);
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef BVTHandler_h
+#define BVTHandler_h
+
+#include "UFTHandler.h"
+#include "BVLogic.h"
+#include "AIGBitBlaster.h"
+
+//
+// The bit-vectors are bit-blasted before the formula reaches the SAT
+// solver, so the only theory solver is the egraph for the remaining
+// uninterpreted terms.  The handler keeps the bit-blaster to give the
+// values of the bit-vector variables in the model.
+//
+class BVTHandler : public UFTHandler
+{
+  private:
+    BVLogic&      logic;
+    AIGBitBlaster bitBlaster;
+  public:
+    BVTHandler(SMTConfig & c, BVLogic & l);
+    virtual ~BVTHandler();
+    virtual BVLogic& getLogic() override;
+    virtual const BVLogic& getLogic() const override;
+    virtual void fillTheoryFunctions(ModelBuilder & modelBuilder) const override;
+    AIGBitBlaster& getBitBlaster() { return bitBlaster; }
+};
+#endif
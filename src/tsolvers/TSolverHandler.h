@@ -66,14 +66,14 @@ public:
     virtual const Logic& getLogic() const = 0;
     virtual PTRef getInterpolant(const ipartitions_t& mask, map<PTRef, icolor_t>*, PartitionManager& pmanager) = 0;
 
-    void    fillTheoryFunctions(ModelBuilder& modelBuilder) const;
+    virtual void fillTheoryFunctions(ModelBuilder& modelBuilder) const;
     void    computeModel      ();                      // Computes a model in the solver if necessary
     bool    assertLit         (PtAsgn);                // Push the assignment to all theory solvers
     void    informNewSplit(PTRef);                     // Recompute split datastructures
     void    declareAtom(PTRef tr);                     // Declare atom to the appropriate solver
 //    virtual SolverId getId() const { return my_id; }
     virtual lbool getPolaritySuggestion(PTRef) const { return l_Undef; }
-    TRes    check(bool);
+    virtual TRes check(bool);
     virtual vec<PTRef> getSplitClauses();
 private:
     // Helper method for computing reasons
@@ -3,6 +3,8 @@
 #include "TreeOps.h"
 #include "Egraph.h"
 
+#include <unordered_map>
+
 UFLATHandler::UFLATHandler(SMTConfig & c, ArithLogic & l)
         : TSolverHandler(c)
         , logic(l)
@@ -31,3 +33,69 @@ lbool UFLATHandler::getPolaritySuggestion(PTRef pt) const {
     return l_Undef;
 }
 
+
+void UFLATHandler::addInterfaceVars(vec<PTRef> const & vars) {
+    for (PTRef var : vars) {
+        if (isInterfaceVar.insert(var).second) {
+            interfaceVars.push(var);
+        }
+    }
+}
+
+TRes UFLATHandler::check(bool complete) {
+    combinationSplits.clear();
+    TRes res = TSolverHandler::check(complete);
+    // The models can be compared only when the assignment is complete and the arithmetic model is final
+    if (res == TRes::SAT and complete and not config.uf_la_eager_combination() and not lasolver->hasNewSplits()) {
+        combineModels();
+    }
+    return res;
+}
+
+vec<PTRef> UFLATHandler::getSplitClauses() {
+    vec<PTRef> splits = TSolverHandler::getSplitClauses();
+    if (splits.size() == 0) {
+        combinationSplits.moveTo(splits);
+    }
+    return splits;
+}
+
+/*
+ * The interface variables equal in the arithmetic model must be in the same congruence class and the ones in the same
+ * class must have the same value.  Instead of adding the interface clauses for all pairs up front, they are added only
+ * for the pairs on which the two solvers disagree.  Grouping the variables by value and by class finds these pairs
+ * without comparing all pairs.
+ */
+void UFLATHandler::combineModels() {
+    if (interfaceVars.size() < 2) { return; }
+    auto values = lasolver->getModelValues(interfaceVars);
+    std::unordered_map<opensmt::Real, PTRef, FastRationalHash> varWithValue;
+    std::unordered_map<PTRef, std::size_t, PTRefHash> varInClass;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        auto const & [var, value] = values[i];
+        PTRef root = ufsolver->getRootTerm(var);
+        if (root == PTRef_Undef) { continue; }
+        auto [sameValue, newValue] = varWithValue.emplace(value, var);
+        if (not newValue and ufsolver->getRootTerm(sameValue->second) != root) {
+            addInterfaceClauses(sameValue->second, var);
+        }
+        auto [sameClass, newClass] = varInClass.emplace(root, i);
+        if (not newClass and values[sameClass->second].second != value) {
+            addInterfaceClauses(values[sameClass->second].first, var);
+        }
+    }
+}
+
+void UFLATHandler::addInterfaceClauses(PTRef x, PTRef y) {
+    if (logic.isNumConst(x) and logic.isNumConst(y)) { return; }
+    if (y.x < x.x) { std::swap(x, y); }
+    // Once the SAT solver has the clauses, it cannot assign the atoms of the pair so that the models disagree on it
+    if (not combinedPairs.insert({x, y}).second) { return; }
+    PTRef eq = logic.mkEq(x, y);
+    PTRef leq = logic.mkLeq(x, y);
+    PTRef geq = logic.mkGeq(x, y);
+    // x = y <=> x <= y && x >= y
+    combinationSplits.push(logic.mkOr({logic.mkNot(eq), leq}));
+    combinationSplits.push(logic.mkOr({logic.mkNot(eq), geq}));
+    combinationSplits.push(logic.mkOr({logic.mkNot(leq), logic.mkNot(geq), eq}));
+}
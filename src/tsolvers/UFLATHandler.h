@@ -29,6 +29,8 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "TSolverHandler.h"
 #include "ArithLogic.h"
 
+#include <unordered_set>
+
 class Egraph;
 class LASolver;
 
@@ -38,6 +40,15 @@ class UFLATHandler : public TSolverHandler
     ArithLogic      &logic;
     LASolver      *lasolver;
     Egraph        *ufsolver;
+
+    // Model-based theory combination (de Moura and Bjorner, SMT 2008)
+    vec<PTRef>    interfaceVars;                 // Terms shared by the arithmetic and the uninterpreted functions
+    std::unordered_set<PTRef, PTRefHash> isInterfaceVar;
+    std::unordered_set<std::pair<PTRef, PTRef>, PTRefPairHash> combinedPairs; // Pairs whose interface clauses the SAT solver already has
+    vec<PTRef>    combinationSplits;             // Interface clauses of the pairs on which the models disagree
+
+    void    combineModels();                     // Compare the arithmetic model to the congruence classes
+    void    addInterfaceClauses(PTRef x, PTRef y);
   public:
     UFLATHandler(SMTConfig & c, ArithLogic & l);
     ~UFLATHandler() override = default;
@@ -47,6 +58,10 @@ class UFLATHandler : public TSolverHandler
     PTRef getInterpolant(const ipartitions_t& mask, map<PTRef, icolor_t> *labels, PartitionManager &pmanager) override;
 
     lbool getPolaritySuggestion(PTRef pt) const override;
+
+    void addInterfaceVars(vec<PTRef> const & vars);
+    TRes check(bool complete) override;
+    vec<PTRef> getSplitClauses() override;
 };
 
 #endif
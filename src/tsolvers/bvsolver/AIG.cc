@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "AIG.h"
+
+#include <utility>
+
+AigLit AIG::mkInput() {
+    nodes.push_back({AigLit_Undef, AigLit_Undef});
+    return {static_cast<uint32_t>(nodes.size() - 1) << 1};
+}
+
+AigLit AIG::mkAnd(AigLit a, AigLit b) {
+    if (a.x > b.x) { std::swap(a, b); }
+    // Constants are the smallest literals
+    if (a == AigLit_False) { return AigLit_False; }
+    if (a == AigLit_True) { return b; }
+    if (a == b) { return a; }
+    if (a == ~b) { return AigLit_False; }
+    auto [it, inserted] = strash.insert({key(a, b), nodes.size()});
+    if (inserted) {
+        nodes.push_back({a, b});
+    }
+    return {it->second << 1};
+}
+
+AigLit AIG::mkXor(AigLit a, AigLit b) {
+    if (a.x > b.x) { std::swap(a, b); }
+    if (a == AigLit_False) { return b; }
+    if (a == AigLit_True) { return ~b; }
+    if (a == b) { return AigLit_False; }
+    if (a == ~b) { return AigLit_True; }
+    return mkOr(mkAnd(a, ~b), mkAnd(~a, b));
+}
+
+AigLit AIG::mkIte(AigLit c, AigLit t, AigLit e) {
+    if (c == AigLit_True) { return t; }
+    if (c == AigLit_False) { return e; }
+    if (t == e) { return t; }
+    if (t == ~e) { return mkEquiv(c, t); }
+    return mkOr(mkAnd(c, t), mkAnd(~c, e));
+}
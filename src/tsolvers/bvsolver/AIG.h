@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OPENSMT_AIG_H
+#define OPENSMT_AIG_H
+
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// A literal of the and-inverter graph: the index of a node and a sign bit.
+struct AigLit {
+    uint32_t x;
+    inline friend bool operator== (AigLit a1, AigLit a2) { return a1.x == a2.x; }
+    inline friend bool operator!= (AigLit a1, AigLit a2) { return a1.x != a2.x; }
+    inline friend AigLit operator~ (AigLit a) { return {a.x ^ 1u}; }
+    uint32_t node() const { return x >> 1; }
+    bool sign() const { return x & 1u; }
+};
+
+// Node 0 is the constant false
+const AigLit AigLit_False = {0};
+const AigLit AigLit_True = {1};
+const AigLit AigLit_Undef = {UINT32_MAX};
+
+//
+// And-inverter graph with structural hashing.  The and-nodes are
+// created only through mkAnd, which propagates constants, simplifies
+// the trivial cases and returns an existing node for the same pair of
+// fanins.  Nodes are numbered in topological order.
+//
+class AIG {
+    struct Node {
+        AigLit left;
+        AigLit right;
+    };
+    std::vector<Node> nodes;
+    std::unordered_map<uint64_t, uint32_t> strash; // (left, right) -> node
+
+    static uint64_t key(AigLit a, AigLit b) { return (static_cast<uint64_t>(a.x) << 32) | b.x; }
+
+public:
+    AIG() : nodes({{AigLit_Undef, AigLit_Undef}}) {}
+
+    AigLit mkInput();
+    AigLit mkAnd(AigLit a, AigLit b);
+    AigLit mkOr(AigLit a, AigLit b) { return ~mkAnd(~a, ~b); }
+    AigLit mkXor(AigLit a, AigLit b);
+    AigLit mkEquiv(AigLit a, AigLit b) { return ~mkXor(a, b); }
+    AigLit mkIte(AigLit c, AigLit t, AigLit e);
+
+    uint32_t size() const { return nodes.size(); }
+    static bool isConstant(AigLit a) { return a.node() == 0; }
+    bool isInput(uint32_t node) const { return node != 0 && nodes[node].left == AigLit_Undef; }
+    bool isAnd(uint32_t node) const { return nodes[node].left != AigLit_Undef; }
+    AigLit getLeft(uint32_t node) const { assert(isAnd(node)); return nodes[node].left; }
+    AigLit getRight(uint32_t node) const { assert(isAnd(node)); return nodes[node].right; }
+};
+
+#endif //OPENSMT_AIG_H
@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "AIGBitBlaster.h"
+
+#include "ModelBuilder.h"
+#include "OsmtApiException.h"
+
+#include <string>
+
+PTRef AIGBitBlaster::blast(PTRef fla) {
+    assert(logic.hasSortBool(fla));
+    BlastConfig config(*this);
+    TermVisitor<BlastConfig>(logic, config).visit(fla);
+    return toTerm(boolBits.at(fla));
+}
+
+bool AIGBitBlaster::BlastConfig::previsit(PTRef tr) {
+    BVLogic & logic = blaster.logic;
+    if (blaster.isBlasted(tr)) {
+        return false;
+    }
+    if (blaster.isBooleanLeaf(tr)) {
+        for (PTRef child : logic.getPterm(tr)) {
+            if (logic.hasSortBVNUM(child)) {
+                throw OsmtApiException("Bit-vector arguments are not supported in " + logic.printTerm(tr));
+            }
+        }
+        blaster.boolBits.insert({tr, blaster.mkInput(tr)});
+        return false;
+    }
+    if (logic.hasSortBVNUM(tr) and logic.isVar(tr)) {
+        std::string const name = logic.getSymName(tr);
+        Bits bits;
+        for (int i = 0; i < logic.getBitWidth(); i++) {
+            std::string bitName = ".bv" + std::to_string(i) + "_" + name;
+            bits.push_back(blaster.mkInput(logic.mkBoolVar(bitName.c_str())));
+        }
+        blaster.bvBits.insert({tr, std::move(bits)});
+        blaster.bvVars.push_back(tr);
+        return false;
+    }
+    if (logic.hasSortBVNUM(tr) and logic.isConstant(tr)) {
+        blaster.bvBits.insert({tr, blaster.constant(tr)});
+        return false;
+    }
+    return true;
+}
+
+void AIGBitBlaster::BlastConfig::visit(PTRef tr) {
+    if (blaster.logic.hasSortBool(tr)) {
+        blaster.blastBool(tr);
+    } else if (blaster.logic.hasSortBVNUM(tr)) {
+        blaster.blastBV(tr);
+    } else {
+        throw OsmtApiException("Term not supported by the bit-blaster: " + blaster.logic.printTerm(tr));
+    }
+}
+
+bool AIGBitBlaster::isBooleanLeaf(PTRef tr) const {
+    if (not logic.hasSortBool(tr) or logic.isTrue(tr) or logic.isFalse(tr) or logic.isBooleanOperator(tr)) {
+        return false;
+    }
+    Pterm const & term = logic.getPterm(tr);
+    return not ((logic.isEquality(tr) or logic.isDisequality(tr)) and logic.hasSortBVNUM(term[0]));
+}
+
+AigLit AIGBitBlaster::mkInput(PTRef tr) {
+    AigLit lit = aig.mkInput();
+    nodeTerms.resize(aig.size(), PTRef_Undef);
+    nodeTerms[lit.node()] = tr;
+    return lit;
+}
+
+void AIGBitBlaster::blastBool(PTRef tr) {
+    Pterm const & term = logic.getPterm(tr);
+    auto arg = [&](int i) { return boolBits.at(term[i]); };
+    AigLit res = AigLit_Undef;
+    if (logic.isTrue(tr)) {
+        res = AigLit_True;
+    } else if (logic.isFalse(tr)) {
+        res = AigLit_False;
+    } else if (logic.isNot(tr)) {
+        res = ~arg(0);
+    } else if (logic.isAnd(tr) or logic.isOr(tr)) {
+        bool isOr = logic.isOr(tr);
+        res = isOr ? AigLit_False : AigLit_True;
+        for (int i = 0; i < term.size(); i++) {
+            res = isOr ? aig.mkOr(res, arg(i)) : aig.mkAnd(res, arg(i));
+        }
+    } else if (logic.isImplies(tr)) {
+        res = arg(term.size() - 1);
+        for (int i = term.size() - 2; i >= 0; i--) {
+            res = aig.mkOr(~arg(i), res);
+        }
+    } else if (logic.isXor(tr)) {
+        res = AigLit_False;
+        for (int i = 0; i < term.size(); i++) {
+            res = aig.mkXor(res, arg(i));
+        }
+    } else if (logic.isIte(tr)) {
+        res = aig.mkIte(arg(0), arg(1), arg(2));
+    } else if (logic.isEquality(tr) or logic.isDisequality(tr)) {
+        bool bitVectors = logic.hasSortBVNUM(term[0]);
+        auto equal = [&](int i, int j) {
+            return bitVectors ? this->equal(bvBits.at(term[i]), bvBits.at(term[j])) : aig.mkEquiv(arg(i), arg(j));
+        };
+        res = AigLit_True;
+        if (logic.isEquality(tr)) {
+            for (int i = 1; i < term.size(); i++) {
+                res = aig.mkAnd(res, equal(i - 1, i));
+            }
+        } else {
+            for (int i = 0; i < term.size(); i++) {
+                for (int j = i + 1; j < term.size(); j++) {
+                    res = aig.mkAnd(res, ~equal(i, j));
+                }
+            }
+        }
+    }
+    assert(res != AigLit_Undef);
+    boolBits.insert({tr, res});
+}
+
+void AIGBitBlaster::blastBV(PTRef tr) {
+    Pterm const & term = logic.getPterm(tr);
+    auto arg = [&](int i) -> Bits const & { return bvBits.at(term[i]); };
+    // Applies a binary operation to the arguments from left to right
+    auto fold = [&](auto op) {
+        Bits res = arg(0);
+        for (int i = 1; i < term.size(); i++) {
+            res = op(res, arg(i));
+        }
+        return res;
+    };
+    Bits res;
+    if (logic.isIte(tr)) {
+        res = ite(boolBits.at(term[0]), arg(1), arg(2));
+    } else if (logic.isBVPlus(tr)) {
+        res = fold([this](Bits const & a, Bits const & b) { return add(a, b, AigLit_False); });
+    } else if (logic.isBVNeg(tr)) {
+        res = negate(arg(0));
+    } else if (logic.isBVMinus(tr)) {
+        res = fold([this](Bits const & a, Bits const & b) { return add(a, negate(b), AigLit_False); });
+    } else if (logic.isBVTimes(tr)) {
+        res = fold([this](Bits const & a, Bits const & b) { return multiply(a, b); });
+    } else if (logic.isBVDiv(tr) or logic.isBVMod(tr)) {
+        bool quotient = logic.isBVDiv(tr);
+        res = fold([this, quotient](Bits const & a, Bits const & b) {
+            Bits q, r;
+            divide(a, b, q, r);
+            return quotient ? q : r;
+        });
+    } else if (logic.isBVBwAnd(tr)) {
+        res = fold([this](Bits const & a, Bits const & b) { return bitwise(a, b, &AIG::mkAnd); });
+    } else if (logic.isBVBwOr(tr)) {
+        res = fold([this](Bits const & a, Bits const & b) { return bitwise(a, b, &AIG::mkOr); });
+    } else if (logic.isBVBwXor(tr)) {
+        res = fold([this](Bits const & a, Bits const & b) { return bitwise(a, b, &AIG::mkXor); });
+    } else if (logic.isBVCompl(tr)) {
+        for (AigLit bit : arg(0)) {
+            res.push_back(~bit);
+        }
+    } else if (logic.isBVLshift(tr) or logic.isBVLRshift(tr) or logic.isBVARshift(tr)) {
+        bool left = logic.isBVLshift(tr);
+        bool arithmetic = logic.isBVARshift(tr);
+        res = fold([this, left, arithmetic](Bits const & a, Bits const & b) { return shift(a, b, left, arithmetic); });
+    } else if (logic.isBVNot(tr)) {
+        res = fromBool(~nonZero(arg(0)));
+    } else if (logic.isBVLand(tr) or logic.isBVLor(tr)) {
+        bool isOr = logic.isBVLor(tr);
+        AigLit value = isOr ? AigLit_False : AigLit_True;
+        for (int i = 0; i < term.size(); i++) {
+            value = isOr ? aig.mkOr(value, nonZero(arg(i))) : aig.mkAnd(value, nonZero(arg(i)));
+        }
+        res = fromBool(value);
+    } else if (logic.isBVEq(tr)) {
+        res = fromBool(equal(arg(0), arg(1)));
+    } else if (logic.isBVSlt(tr) or logic.isBVUlt(tr) or logic.isBVSgt(tr) or logic.isBVUgt(tr)) {
+        bool isSigned = logic.isBVSlt(tr) or logic.isBVSgt(tr);
+        bool greater = logic.isBVSgt(tr) or logic.isBVUgt(tr);
+        res = fromBool(greater ? lessThan(arg(1), arg(0), isSigned) : lessThan(arg(0), arg(1), isSigned));
+    } else if (logic.isBVSleq(tr) or logic.isBVUleq(tr) or logic.isBVSgeq(tr) or logic.isBVUgeq(tr)) {
+        bool isSigned = logic.isBVSleq(tr) or logic.isBVSgeq(tr);
+        bool greater = logic.isBVSgeq(tr) or logic.isBVUgeq(tr);
+        res = fromBool(~(greater ? lessThan(arg(0), arg(1), isSigned) : lessThan(arg(1), arg(0), isSigned)));
+    } else {
+        throw OsmtApiException("Term not supported by the bit-blaster: " + logic.printTerm(tr));
+    }
+    assert(res.size() == static_cast<std::size_t>(logic.getBitWidth()));
+    bvBits.insert({tr, std::move(res)});
+}
+
+//
+// Returns the term of the literal, creating the conjunctions for the
+// nodes below it that do not have a term yet.
+//
+PTRef AIGBitBlaster::toTerm(AigLit lit) {
+    nodeTerms.resize(aig.size(), PTRef_Undef);
+    auto litTerm = [this](AigLit l) {
+        PTRef tr = nodeTerms[l.node()];
+        return l.sign() ? logic.mkNot(tr) : tr;
+    };
+    std::vector<uint32_t> queue {lit.node()};
+    while (not queue.empty()) {
+        uint32_t node = queue.back();
+        if (nodeTerms[node] != PTRef_Undef) {
+            queue.pop_back();
+            continue;
+        }
+        AigLit left = aig.getLeft(node);
+        AigLit right = aig.getRight(node);
+        bool ready = true;
+        for (AigLit child : {left, right}) {
+            if (nodeTerms[child.node()] == PTRef_Undef) {
+                queue.push_back(child.node());
+                ready = false;
+            }
+        }
+        if (ready) {
+            nodeTerms[node] = logic.mkAnd(litTerm(left), litTerm(right));
+            queue.pop_back();
+        }
+    }
+    return litTerm(lit);
+}
+
+void AIGBitBlaster::fillModel(ModelBuilder & modelBuilder) const {
+    for (PTRef var : bvVars) {
+        Bits const & bits = bvBits.at(var);
+        std::string value(bits.size(), '0');
+        for (std::size_t i = 0; i < bits.size(); i++) {
+            PTRef bit = nodeTerms[bits[i].node()];
+            if (modelBuilder.hasVarVal(bit) and modelBuilder.getVarVal(bit) == logic.getTerm_true()) {
+                value[bits.size() - 1 - i] = '1';
+            }
+        }
+        modelBuilder.addVarValue(var, logic.mkConst(logic.getSort_BVNUM(), value.c_str()));
+    }
+}
+
+AIGBitBlaster::Bits AIGBitBlaster::fromBool(AigLit lit) const {
+    Bits res(logic.getBitWidth(), AigLit_False);
+    res[0] = lit;
+    return res;
+}
+
+// The constants of BVLogic are written in binary, the most significant bit first
+AIGBitBlaster::Bits AIGBitBlaster::constant(PTRef tr) const {
+    std::string const name = logic.getSymName(tr);
+    std::size_t const width = logic.getBitWidth();
+    if (name.size() != width or name.find_first_not_of("01") != std::string::npos) {
+        throw OsmtApiException("Not a binary constant of width " + std::to_string(width) + ": " + name);
+    }
+    Bits res;
+    for (std::size_t i = 0; i < width; i++) {
+        res.push_back(name[width - 1 - i] == '1' ? AigLit_True : AigLit_False);
+    }
+    return res;
+}
+
+AIGBitBlaster::Bits AIGBitBlaster::bitwise(Bits const & a, Bits const & b, AigLit (AIG::*op)(AigLit, AigLit)) {
+    Bits res;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        res.push_back((aig.*op)(a[i], b[i]));
+    }
+    return res;
+}
+
+AIGBitBlaster::Bits AIGBitBlaster::negate(Bits const & a) {
+    Bits complement;
+    for (AigLit bit : a) {
+        complement.push_back(~bit);
+    }
+    return add(complement, Bits(a.size(), AigLit_False), AigLit_True);
+}
+
+// Ripple-carry adder
+AIGBitBlaster::Bits AIGBitBlaster::add(Bits const & a, Bits const & b, AigLit carry, AigLit * carryOut) {
+    Bits res;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        AigLit halfSum = aig.mkXor(a[i], b[i]);
+        res.push_back(aig.mkXor(halfSum, carry));
+        carry = aig.mkOr(aig.mkAnd(a[i], b[i]), aig.mkAnd(carry, halfSum));
+    }
+    if (carryOut) { *carryOut = carry; }
+    return res;
+}
+
+// Shift-and-add multiplier
+AIGBitBlaster::Bits AIGBitBlaster::multiply(Bits const & a, Bits const & b) {
+    std::size_t const width = a.size();
+    Bits res(width, AigLit_False);
+    for (std::size_t i = 0; i < width; i++) {
+        if (b[i] == AigLit_False) { continue; }
+        Bits partial(width, AigLit_False);
+        for (std::size_t j = i; j < width; j++) {
+            partial[j] = aig.mkAnd(a[j - i], b[i]);
+        }
+        res = add(res, partial, AigLit_False);
+    }
+    return res;
+}
+
+//
+// Restoring division.  Division by zero gives all ones as the quotient
+// and the dividend as the remainder.
+//
+void AIGBitBlaster::divide(Bits const & a, Bits const & b, Bits & quotient, Bits & remainder) {
+    std::size_t const width = a.size();
+    Bits negatedDivisor;
+    for (AigLit bit : b) {
+        negatedDivisor.push_back(~bit);
+    }
+    quotient.assign(width, AigLit_False);
+    remainder.assign(width, AigLit_False);
+    for (std::size_t i = width; i-- > 0; ) {
+        // The partial remainder shifted left has width + 1 bits
+        AigLit top = remainder[width - 1];
+        Bits shifted {a[i]};
+        shifted.insert(shifted.end(), remainder.begin(), remainder.end() - 1);
+        AigLit noBorrow;
+        Bits difference = add(shifted, negatedDivisor, AigLit_True, &noBorrow);
+        AigLit geq = aig.mkOr(top, noBorrow);
+        quotient[i] = geq;
+        remainder = ite(geq, difference, shifted);
+    }
+}
+
+// Barrel shifter.  Shifting by at least the width gives the fill bits.
+AIGBitBlaster::Bits AIGBitBlaster::shift(Bits const & a, Bits const & amount, bool left, bool arithmetic) {
+    std::size_t const width = a.size();
+    AigLit fill = arithmetic ? a[width - 1] : AigLit_False;
+    AigLit overflow = AigLit_False;
+    Bits res = a;
+    for (std::size_t k = 0; k < amount.size(); k++) {
+        if (k >= 32 or (std::size_t{1} << k) >= width) {
+            overflow = aig.mkOr(overflow, amount[k]);
+            continue;
+        }
+        std::size_t const distance = std::size_t{1} << k;
+        Bits shifted(width, fill);
+        for (std::size_t j = 0; j < width; j++) {
+            if (left) {
+                shifted[j] = j >= distance ? res[j - distance] : AigLit_False;
+            } else if (j + distance < width) {
+                shifted[j] = res[j + distance];
+            }
+        }
+        res = ite(amount[k], shifted, res);
+    }
+    return ite(overflow, Bits(width, left ? AigLit_False : fill), res);
+}
+
+AIGBitBlaster::Bits AIGBitBlaster::ite(AigLit c, Bits const & t, Bits const & e) {
+    Bits res;
+    for (std::size_t i = 0; i < t.size(); i++) {
+        res.push_back(aig.mkIte(c, t[i], e[i]));
+    }
+    return res;
+}
+
+AigLit AIGBitBlaster::nonZero(Bits const & a) {
+    AigLit res = AigLit_False;
+    for (AigLit bit : a) {
+        res = aig.mkOr(res, bit);
+    }
+    return res;
+}
+
+AigLit AIGBitBlaster::equal(Bits const & a, Bits const & b) {
+    AigLit res = AigLit_True;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        res = aig.mkAnd(res, aig.mkEquiv(a[i], b[i]));
+    }
+    return res;
+}
+
+// Compares from the least significant bit up; the most significant differing bit decides
+AigLit AIGBitBlaster::lessThan(Bits const & a, Bits const & b, bool isSigned) {
+    AigLit res = AigLit_False;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        bool signBit = isSigned and i == a.size() - 1;
+        res = aig.mkIte(aig.mkXor(a[i], b[i]), signBit ? a[i] : b[i], res);
+    }
+    return res;
+}
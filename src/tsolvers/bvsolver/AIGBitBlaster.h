@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OPENSMT_AIGBITBLASTER_H
+#define OPENSMT_AIGBITBLASTER_H
+
+#include "AIG.h"
+#include "BVLogic.h"
+#include "TreeOps.h"
+
+#include <unordered_map>
+#include <vector>
+
+class ModelBuilder;
+
+//
+// Eager bit-blasting of BVLogic terms.  The bit-vector terms are
+// lowered, together with the Boolean structure above them, into an
+// and-inverter graph, and the graph is returned as a Boolean formula
+// over the bits of the bit-vector variables.  The formula consists of
+// binary conjunctions and negations only, so that the Tseitin
+// encoding of the formula is the encoding of the graph.  Boolean
+// terms that do not contain bit-vectors are kept as they are.
+//
+// Division and remainder are unsigned, and the operators yielding a
+// truth value in the C-like BVLogic produce the bit-vector 0 or 1.
+//
+class AIGBitBlaster {
+    using Bits = std::vector<AigLit>; // The least significant bit first
+
+    class BlastConfig : public DefaultVisitorConfig {
+        AIGBitBlaster & blaster;
+    public:
+        BlastConfig(AIGBitBlaster & blaster) : blaster(blaster) {}
+        bool previsit(PTRef tr) override;
+        void visit(PTRef tr) override;
+    };
+
+    BVLogic & logic;
+    AIG aig;
+    std::unordered_map<PTRef, AigLit, PTRefHash> boolBits;
+    std::unordered_map<PTRef, Bits, PTRefHash> bvBits;
+    std::vector<PTRef> nodeTerms;                          // The term of each node of the graph, once created
+    std::vector<PTRef> bvVars;                             // The bit-vector variables seen so far
+
+    bool isBlasted(PTRef tr) const { return boolBits.find(tr) != boolBits.end() || bvBits.find(tr) != bvBits.end(); }
+    bool isBooleanLeaf(PTRef tr) const;
+    AigLit mkInput(PTRef tr);
+    void blastBool(PTRef tr);
+    void blastBV(PTRef tr);
+    PTRef toTerm(AigLit lit);
+
+    Bits fromBool(AigLit lit) const;
+    Bits constant(PTRef tr) const;
+    Bits bitwise(Bits const & a, Bits const & b, AigLit (AIG::*op)(AigLit, AigLit));
+    Bits negate(Bits const & a);
+    Bits add(Bits const & a, Bits const & b, AigLit carry, AigLit * carryOut = nullptr);
+    Bits multiply(Bits const & a, Bits const & b);
+    void divide(Bits const & a, Bits const & b, Bits & quotient, Bits & remainder);
+    Bits shift(Bits const & a, Bits const & amount, bool left, bool arithmetic);
+    Bits ite(AigLit c, Bits const & t, Bits const & e);
+    AigLit nonZero(Bits const & a);
+    AigLit equal(Bits const & a, Bits const & b);
+    AigLit lessThan(Bits const & a, Bits const & b, bool isSigned);
+
+public:
+    AIGBitBlaster(BVLogic & logic) : logic(logic), nodeTerms({logic.getTerm_false()}) {}
+
+    // Returns a Boolean formula over the bits that is equisatisfiable with fla
+    PTRef blast(PTRef fla);
+    // Adds the values of the bit-vector variables, computed from the values of their bits in modelBuilder
+    void fillModel(ModelBuilder & modelBuilder) const;
+    uint32_t getGraphSize() const { return aig.size(); }
+};
+
+#endif //OPENSMT_AIGBITBLASTER_H
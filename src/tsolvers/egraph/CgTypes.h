@@ -27,8 +27,11 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef CGTYPES_H
 #define CGTYPES_H
 
+#include <cstdint>
+
 typedef uint32_t cgId;
 typedef uint32_t dist_t;
 static cgId const cgId_Nil = 0;
-static int const maxDistinctClasses = 8*sizeof(dist_t);
+static uint32_t const distClassesPerWord = 8*sizeof(dist_t);
+static uint32_t const distExt_None = UINT32_MAX;
 #endif
@@ -43,7 +43,10 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "GCTest.h"
 #endif
 
+#include <map>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 class UFSolverStats
 {
@@ -52,13 +55,15 @@ class UFSolverStats
         opensmt::OSMTTimeVal egraph_backtrack_timer;
         opensmt::OSMTTimeVal egraph_explain_timer;
         int num_eq_classes;
-        UFSolverStats() : num_eq_classes(0) {}
+        int cached_reasons;
+        UFSolverStats() : num_eq_classes(0), cached_reasons(0) {}
         void printStatistics(std::ostream & os)
         {
             os << "; egraph time..............: " << egraph_asrt_timer.getTime() << " s\n";
             os << "; backtrack time...........: " << egraph_backtrack_timer.getTime() << " s\n";
             os << "; explain time.............: " << egraph_explain_timer.getTime() << " s\n";
             os << "; # eq classes at the end..: " << num_eq_classes << "\n";
+            os << "; cached reasons...........: " << cached_reasons << "\n";
         }
 };
 
@@ -187,7 +192,12 @@ private:
 
     EnodeStore enode_store;
 
-    bool isValid(PTRef tr) override { return logic.isTheoryEquality(tr) || logic.isUP(tr) || logic.isDisequality(tr); }
+    // The distinction classes of an enode beyond the ones stored in the enode itself.  An enode has a bit vector
+    // here only after it has been the root of a class in such a distinction.
+    std::vector<std::vector<dist_t>> dist_ext;
+
+    // Boolean terms appearing as arguments of uninterpreted functions can be deduced, so the egraph has to explain them
+    bool isValid(PTRef tr) override { return logic.isTheoryEquality(tr) || logic.isUP(tr) || logic.isDisequality(tr) || (logic.hasSortBool(tr) && logic.appearsInUF(tr)); }
     bool isEffectivelyEquality(PTRef tr) const;
     bool isEffectivelyUP(PTRef tr) const;
     bool isEffectivelyDisequality(PTRef tr) const;
@@ -196,6 +206,20 @@ private:
 
     UFSolverStats egraphStats;
 
+    // The reasons of deduced literals.  A reason stays valid while the literals in it are asserted, that is, until
+    // the undo stack goes below the position where the last of them was asserted.
+    struct CachedReason {
+        lbool sgn;
+        std::size_t height;
+        std::vector<PtAsgn> reason;
+    };
+    bool cacheReasons;
+    std::unordered_map<PTRef, CachedReason, PTRefHash> reasonCache;
+    std::multimap<std::size_t, PTRef> reasonCacheHeights;
+    std::vector<std::size_t> assertionPositions;                   // Size of the undo stack after asserting a term, by term id
+    std::size_t getAssertionPosition(PTRef tr) const;
+    void invalidateReasons(std::size_t height);
+
     class Values {
         Map<ERef, ERef, ERefHash> values;
         Map<ERef, int, ERefHash> valueERefToInt;
@@ -241,6 +265,11 @@ public:
 
     PTRef ERefToTerm(ERef er) const { return getEnode(er).getTerm(); }
 
+    // The term representing the equivalence class of tr, or PTRef_Undef if tr has no enode
+    PTRef getRootTerm(PTRef tr) const {
+        return enode_store.has(tr) ? ERefToTerm(getEnode(enode_store.getERef(tr)).getRoot()) : PTRef_Undef;
+    }
+
     bool isConstant(ERef er) const {
         return logic.isConstant(getEnode(er).getTerm());
     }
@@ -271,6 +300,7 @@ public:
     PTRef      getSuggestion           ();                          // Return a suggested literal based on the current state
     lbool      getPolaritySuggestion   (PTRef);                     // Return a suggested polarity for a given literal
     void       getConflict             (vec<PtAsgn> &) override;
+    vec<PtAsgn> getReasonFor           (PtAsgn) override;           // Return the reason of a deduced literal, possibly cached
     TRes       check                   (bool) override { return TRes::SAT; }// Check satisfiability
     void       computeModel            () override;
     void       fillTheoryFunctions     (ModelBuilder & modelBuilder) const override;
@@ -353,6 +383,7 @@ private:
     void    merge           ( ERef, ERef, PtAsgn );               // Merge two nodes
     bool    mergeLoop       ( PtAsgn reason );                    // Merge loop
     void    deduce          ( ERef, ERef, PtAsgn );               // Deduce from merging of two nodes (record the reason)
+    void    deduceEqualities( ERef, PtAsgn );                     // Deduce the equalities among the parents of a class
     void    undoMerge       ( ERef );                             // Undoes a merge
     void    undoDisequality ( ERef );                             // Undoes a disequality
     void    undoDistinction ( PTRef );                            // Undoes a distinction
@@ -394,8 +425,11 @@ private:
     // Helper methods
     void mergeForbidLists(ERef to, const Enode & from);
     void unmergeForbidLists(ERef to, const Enode & from);
-    static void mergeDistinctionClasses(Enode & to, const Enode & from);
-    static void unmergeDistinctionClasses(Enode & to, const Enode & from);
+    void mergeDistinctionClasses(Enode & to, const Enode & from);
+    void unmergeDistinctionClasses(Enode & to, const Enode & from);
+    void addDistClass(ERef root, uint32_t index);
+    void clearDistClass(ERef root, uint32_t index);
+    uint32_t getCommonDistClass(Enode const & x, Enode const & y) const; // The smallest shared distinction class, or distExt_None
     void mergeEquivalenceClasses(ERef newroot, ERef oldroot);
     void unmergeEquivalenceClasses(ERef newroot, ERef oldroot);
     void processParentsBeforeMerge(ERef mergedRoot);
@@ -63,6 +63,8 @@ The algorithm and data structures are inspired by the following paper:
 #include "Deductions.h"
 #include "ModelBuilder.h"
 
+#include <algorithm>
+
 
 static SolverDescr descr_uf_solver("UF Solver", "Solver for Quantifier Free Theory of Uninterpreted Functions with Equalities");
 
@@ -79,18 +81,21 @@ Egraph::Egraph(SMTConfig & c, Logic & l, ExplainerType explainerType)
       , logic              (l)
       , enode_store        ( logic )
       , fa_garbage_frac    ( 0.5 )
+      , cacheReasons       ( explainerType == ExplainerType::CLASSIC )
       , values             ( nullptr )
 {
     auto rawExplainer = [this](ExplainerType type) -> Explainer * {
         switch(type) {
             case ExplainerType::CLASSIC: {
-                return new Explainer(enode_store);
+                auto classicExplainer = new Explainer(enode_store, logic);
+                classicExplainer->setMinimizationLimit(config.uf_minimize_explanations());
+                return classicExplainer;
             }
             case ExplainerType::INTERPOLATING: {
-                return new InterpolatingExplainer(enode_store);
+                return new InterpolatingExplainer(enode_store, logic);
             }
             default: {
-                return new Explainer(enode_store);
+                return new Explainer(enode_store, logic);
             }
         }
     }(explainerType);
@@ -152,7 +157,8 @@ lbool Egraph::getPolaritySuggestion(PTRef p)
     if (term.size() > 2) { return l_Undef; } // For now focus on 2 arguments
     PTRef lhs = term[0];
     PTRef rhs = term[1];
-    assert(enode_store.has(lhs) && enode_store.has(rhs));
+    // A Boolean equality appearing as an argument of an uninterpreted function is known to the egraph even if its
+    // arguments are not
     if (!enode_store.has(lhs) || !enode_store.has(rhs)) { return l_Undef; }
     ERef e_lhs = termToERef(lhs);
     ERef e_rhs = termToERef(rhs);
@@ -188,6 +194,44 @@ void Egraph::getConflict(vec<PtAsgn> & conflict)
 #endif
 }
 
+vec<PtAsgn> Egraph::getReasonFor(PtAsgn lit) {
+    if (not cacheReasons) {
+        return TSolver::getReasonFor(lit);
+    }
+    if (auto it = reasonCache.find(lit.tr); it != reasonCache.end() and it->second.sgn == lit.sgn) {
+        egraphStats.cached_reasons++;
+        vec<PtAsgn> reason;
+        for (PtAsgn pta : it->second.reason) {
+            reason.push(pta);
+        }
+        return reason;
+    }
+    vec<PtAsgn> reason = TSolver::getReasonFor(lit);
+    std::size_t height = 0;
+    for (PtAsgn pta : reason) {
+        if (pta.tr != lit.tr) {
+            height = std::max(height, getAssertionPosition(pta.tr));
+        }
+    }
+    reasonCache[lit.tr] = {lit.sgn, height, {reason.begin(), reason.end()}};
+    reasonCacheHeights.emplace(height, lit.tr);
+    return reason;
+}
+
+std::size_t Egraph::getAssertionPosition(PTRef tr) const {
+    uint32_t id = Idx(logic.getPterm(tr).getId());
+    return id < assertionPositions.size() ? assertionPositions[id] : 0;
+}
+
+void Egraph::invalidateReasons(std::size_t height) {
+    for (auto it = reasonCacheHeights.upper_bound(height); it != reasonCacheHeights.end(); it = reasonCacheHeights.erase(it)) {
+        auto cached = reasonCache.find(it->second);
+        if (cached != reasonCache.end() and cached->second.height == it->first) {
+            reasonCache.erase(cached);
+        }
+    }
+}
+
 void Egraph::clearModel()
 {
     values.reset(nullptr);
@@ -546,7 +590,12 @@ bool Egraph::assertNEq ( PTRef x, PTRef y, const Expl &r ) {
         doExplain(xe, ye, r.pta);
         return false;
     }
-    return assertNEq(p, q, r);
+    bool res = assertNEq(p, q, r);
+    if (res) {
+        // The equalities between the two classes now cannot hold; they are among the parents of both
+        deduceEqualities(getParentsSize(p) < getParentsSize(q) ? p : q, r.pta);
+    }
+    return res;
 }
 
 bool Egraph::assertNEq(ERef p, ERef q, Expl const & r)
@@ -650,7 +699,7 @@ bool Egraph::assertDist( PTRef tr_d, PtAsgn tr_r )
 
         // Activate distinction in e
         // This should be done for the root of en_c, not en_c
-        getEnode(root).addDistClass(index);
+        addDistClass(root, index);
         nodes_changed.push(root);
     }
 
@@ -665,7 +714,7 @@ bool Egraph::assertDist( PTRef tr_d, PtAsgn tr_r )
         // Revert changes, as the current context is inconsistent
         for (ERef n : nodes_changed) {
             // Deactivate distinction in n
-            getEnode(n).clearDistClass(index);
+            clearDistClass(n, index);
         }
         return false;
     }
@@ -678,8 +727,9 @@ bool Egraph::assertDist( PTRef tr_d, PtAsgn tr_r )
 void Egraph::undoDistinction(PTRef tr_d) {
     auto index = enode_store.getDistIndex(tr_d);
     Pterm const & pt_d = logic.getPterm(tr_d);
+    // The merges after the distinction have been undone, so the roots are the ones the distinction was asserted on
     for (PTRef tr_c : pt_d) {
-        getEnode(enode_store.getERef(tr_c)).clearDistClass(index);
+        clearDistClass(getEnode(enode_store.getERef(tr_c)).getRoot(), index);
     }
 }
 
@@ -691,6 +741,7 @@ void Egraph::backtrackToStackSize ( size_t size ) {
     // (might be empty, though, if boolean backtracking happens)
     explanation.clear();
     has_explanation = false;
+    invalidateReasons(size);
     vec<ERef> toReanalyze;
 
     //
@@ -813,6 +864,9 @@ void Egraph::merge ( ERef x, ERef y, PtAsgn reason )
     // Step 5.3: Union of equivalence classes
     mergeEquivalenceClasses(x, y);
 
+    // Deduce the equalities that now hold or cannot hold
+    deduceEqualities(y, reason);
+
     // Step 5.5: Insert new signatures and propagate congruences
     processParentsAfterMerge(y);
 
@@ -823,6 +877,39 @@ void Egraph::merge ( ERef x, ERef y, PtAsgn reason )
     undo_stack_main.push( Undo(MERGE,y) );
 }
 
+//
+// Deduce the unassigned equality atoms among the parents of the class that has
+// er as its root (or had, in case of a merge).  An equality holds if both of its
+// arguments are in the same class, and does not hold if their classes are
+// unmergeable.  The reasons are computed lazily by asserting the negation.
+//
+// Equalities appearing in uninterpreted functions are not deduced, since the
+// egraph would not merge them with true or false when they are asserted.
+//
+void Egraph::deduceEqualities(ERef er, PtAsgn reason) {
+    for (auto entry : parents[getEnode(er).getCid()]) {
+        if (not entry.isValid()) { continue; }
+        Enode const & parent = getEnode(UseVector::entryToERef(entry));
+        PTRef tr = parent.getTerm();
+        if (not logic.isEquality(tr) or parent.getSize() != 2 or not isInformed(tr) or hasPolarity(tr) or logic.appearsInUF(tr)) {
+            continue;
+        }
+        ERef lhs = getEnode(parent[0]).getRoot();
+        ERef rhs = getEnode(parent[1]).getRoot();
+        Expl tmp;
+        if (lhs == rhs) {
+            storeDeduction(PtAsgn_reason(tr, l_True, reason.tr));
+        } else if (unmergeable(lhs, rhs, tmp)) {
+            storeDeduction(PtAsgn_reason(tr, l_False, reason.tr));
+        } else {
+            continue;
+        }
+#ifdef STATISTICS
+        generalTSolverStats.deductions_done ++;
+#endif
+    }
+}
+
 //
 // Deduce facts from the merge of x and y
 //
@@ -1047,14 +1134,7 @@ bool Egraph::unmergeable(ERef x, ERef y, Expl& r) const
     Enode const & en_p = getEnode(p);
     Enode const & en_q = getEnode(q);
 
-    if (dist_t intersection = en_p.getDistClasses() & en_q.getDistClasses()) {
-        // Compute the first index in the intersection
-        // TODO: Use index = std::countr_zero<unsigned>(intersection) when c++20 becomes available?
-        unsigned index = 0;
-        while ((intersection & 1) == 0) {
-            intersection = intersection >> 1;
-            ++index;
-        }
+    if (uint32_t index = getCommonDistClass(en_p, en_q); index != distExt_None) {
         // Dist terms are all inequalities, hence their polarity's true
         PTRef ineq_tr = enode_store.getDistTerm(index);
         r = Expl(Expl::Type::std, {ineq_tr, l_True}, PTRef_Undef);
@@ -1132,6 +1212,13 @@ bool Egraph::assertLit(PtAsgn pta)
     bool res = true; // MB: true means NO conflict, false means conflict
     undo_stack_main.push(Undo(SET_POLARITY, pt_r));
     setPolarity(pt_r, sgn);
+    if (cacheReasons) {
+        uint32_t id = Idx(logic.getPterm(pt_r).getId());
+        if (id >= assertionPositions.size()) {
+            assertionPositions.resize(id + 1, 0);
+        }
+        assertionPositions[id] = undo_stack_main.size();
+    }
 
     // Issue185: In some cases equalities do not have a recursive definition.
     // They should be treated as UPs.
@@ -1299,10 +1386,84 @@ void Egraph::mergeForbidLists(ERef toRef, const Enode & from) {
 
 void Egraph::mergeDistinctionClasses(Enode & to, const Enode & from) {
     to.setDistClasses( ( to.getDistClasses( ) | from.getDistClasses( ) ) );
+    if (from.getDistExt() == distExt_None) { return; }
+    if (to.getDistExt() == distExt_None) {
+        to.setDistExt(dist_ext.size());
+        dist_ext.emplace_back();
+    }
+    std::vector<dist_t> const & fromExt = dist_ext[from.getDistExt()];
+    std::vector<dist_t> & toExt = dist_ext[to.getDistExt()];
+    if (toExt.size() < fromExt.size()) {
+        toExt.resize(fromExt.size(), 0);
+    }
+    for (std::size_t i = 0; i < fromExt.size(); ++i) {
+        toExt[i] |= fromExt[i];
+    }
 }
 
 void Egraph::unmergeDistinctionClasses(Enode & to, const Enode & from) {
+    // The classes of to and from were disjoint when they were merged
     to.setDistClasses( ( to.getDistClasses() & ~(from.getDistClasses())) );
+    if (from.getDistExt() == distExt_None) { return; }
+    assert(to.getDistExt() != distExt_None);
+    std::vector<dist_t> const & fromExt = dist_ext[from.getDistExt()];
+    std::vector<dist_t> & toExt = dist_ext[to.getDistExt()];
+    assert(toExt.size() >= fromExt.size());
+    for (std::size_t i = 0; i < fromExt.size(); ++i) {
+        toExt[i] &= ~fromExt[i];
+    }
+}
+
+void Egraph::addDistClass(ERef root, uint32_t index) {
+    Enode & en_root = getEnode(root);
+    if (index < distClassesPerWord) {
+        en_root.addDistClass(index);
+        return;
+    }
+    if (en_root.getDistExt() == distExt_None) {
+        en_root.setDistExt(dist_ext.size());
+        dist_ext.emplace_back();
+    }
+    std::vector<dist_t> & ext = dist_ext[en_root.getDistExt()];
+    uint32_t word = index / distClassesPerWord - 1;
+    if (ext.size() <= word) {
+        ext.resize(word + 1, 0);
+    }
+    ext[word] |= dist_t(1) << (index % distClassesPerWord);
+}
+
+void Egraph::clearDistClass(ERef root, uint32_t index) {
+    Enode & en_root = getEnode(root);
+    if (index < distClassesPerWord) {
+        en_root.clearDistClass(index);
+        return;
+    }
+    assert(en_root.getDistExt() != distExt_None);
+    std::vector<dist_t> & ext = dist_ext[en_root.getDistExt()];
+    uint32_t word = index / distClassesPerWord - 1;
+    assert(word < ext.size());
+    ext[word] &= ~(dist_t(1) << (index % distClassesPerWord));
+}
+
+uint32_t Egraph::getCommonDistClass(Enode const & x, Enode const & y) const {
+    auto firstIndex = [](dist_t word) {
+        // TODO: Use index = std::countr_zero<unsigned>(word) when c++20 becomes available?
+        return static_cast<uint32_t>(__builtin_ctz(word));
+    };
+    if (dist_t intersection = x.getDistClasses() & y.getDistClasses()) {
+        return firstIndex(intersection);
+    }
+    if (x.getDistExt() == distExt_None || y.getDistExt() == distExt_None) {
+        return distExt_None;
+    }
+    std::vector<dist_t> const & xExt = dist_ext[x.getDistExt()];
+    std::vector<dist_t> const & yExt = dist_ext[y.getDistExt()];
+    for (std::size_t i = 0; i < std::min(xExt.size(), yExt.size()); ++i) {
+        if (dist_t intersection = xExt[i] & yExt[i]) {
+            return (i + 1) * distClassesPerWord + firstIndex(intersection);
+        }
+    }
+    return distExt_None;
 }
 
 void Egraph::mergeEquivalenceClasses(ERef newroot, ERef oldroot) {
@@ -1595,6 +1756,7 @@ void Egraph::removeFromUseVectorsExcept(ERef parent, CgId cgid) {
 void Egraph::printStatistics(std::ostream & os) {
     TSolver::printStatistics(os);
     egraphStats.printStatistics(os);
+    explainer->getStats().printStatistics(os);
 }
 
 void Egraph::reanalyze(ERef eref) {
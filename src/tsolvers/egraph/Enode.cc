@@ -26,7 +26,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "Enode.h"
 
-cgId Enode::cgid_ctr = cgId_Nil+1;
+std::atomic<cgId> Enode::cgid_ctr{cgId_Nil+1};
 UseVectorIndex UseVectorIndex::NotValidIndex = {UINT32_MAX};
 
 Enode::Enode(SymRef symbol, opensmt::span<ERef> children, ERef myRef, PTRef term) :
@@ -37,6 +37,7 @@ Enode::Enode(SymRef symbol, opensmt::span<ERef> children, ERef myRef, PTRef term
     pterm(term),
     forbid(ELRef_Undef),
     dist_classes(0),
+    dist_ext(distExt_None),
     exp_reason(PTRef_Undef, l_Undef),
     exp_parent(ERef_Undef),
     exp_root(myRef),
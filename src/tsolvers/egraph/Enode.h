@@ -35,6 +35,8 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "TypeUtils.h"
 #include "CgTypes.h"
 
+#include <atomic>
+
 struct ERef {
     uint32_t x;
     void operator= (uint32_t v) { x = v; }
@@ -74,7 +76,7 @@ class EnodeAllocator;
 class Enode final
 {
 private:
-    static uint32_t cgid_ctr;
+    static std::atomic<uint32_t> cgid_ctr; // Shared by the egraphs of all threads
 
     ERef    root;           // The root of this enode's equivalence class
     cgId    cid;            // The congruence id of the enode (never changes)
@@ -82,7 +84,8 @@ private:
     int     eq_size;           // Size of this enode's equivalence class
     PTRef   pterm;          // The corresponding pterm
     ELRef   forbid;         // List of unmergeable Enodes
-    dist_t  dist_classes;   // The bit vector for distinction classes
+    dist_t  dist_classes;   // The bit vector for the first distinction classes
+    uint32_t dist_ext;      // The index of the bit vector for the remaining distinction classes in the egraph, or distExt_None
 
     // fields related to explanation
     PtAsgn      exp_reason;
@@ -129,10 +132,12 @@ public:
     PTRef getTerm       ()        const { return pterm; }
     ELRef getForbid     ()        const { return forbid; }
     void  setForbid     (ELRef r)       { forbid = r; }
-    void addDistClass(uint32_t index) { assert(index <= 32); setDistClasses(getDistClasses() | setbit(index)); }
-    void clearDistClass(uint32_t index) { assert(index <= 32); setDistClasses(getDistClasses() & ~setbit(index)); }
+    void addDistClass(uint32_t index) { assert(index < distClassesPerWord); setDistClasses(getDistClasses() | setbit(index)); }
+    void clearDistClass(uint32_t index) { assert(index < distClassesPerWord); setDistClasses(getDistClasses() & ~setbit(index)); }
     void  setDistClasses( const dist_t& d) { dist_classes = d; }
     dist_t getDistClasses() const { return dist_classes; }
+    uint32_t getDistExt() const { return dist_ext; }
+    void setDistExt(uint32_t ext) { dist_ext = ext; }
 
     uint32_t getSize() const { return argSize; }
     SymRef getSymbol() const { return symb; }
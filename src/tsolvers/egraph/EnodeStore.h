@@ -28,7 +28,6 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define ENODESTORE_H
 
 #include "Enode.h"
-#include "OsmtInternalException.h"
 
 class Logic;
 
@@ -74,7 +73,7 @@ class EnodeStore {
     Map<ERef, ERef, SignatureHash, SignatureEqual> sig_tab;
     ERef           ERef_True;
     ERef           ERef_False;
-    Map<PTRef,char,PTRefHash,Equal<PTRef> > dist_classes;
+    Map<PTRef,uint32_t,PTRefHash,Equal<PTRef> > dist_classes;
     uint32_t       dist_idx;
 
     Map<PTRef,ERef,PTRefHash,Equal<PTRef> >    termToERef;
@@ -118,18 +117,15 @@ public:
           Enode& operator[] (PTRef tr)       { return ea[termToERef[tr]]; }
     const Enode& operator[] (PTRef tr) const { return ea[termToERef[tr]]; }
 
-    char getDistIndex(PTRef tr_d) const {
+    uint32_t getDistIndex(PTRef tr_d) const {
         assert(dist_classes.has(tr_d));
         return dist_classes[tr_d];
     }
 
-    PTRef getDistTerm(dist_t idx) const { return index_to_dist[idx]; }
+    PTRef getDistTerm(uint32_t idx) const { return index_to_dist[idx]; }
 
     void addDistClass(PTRef tr_d) {
         if (dist_classes.has(tr_d)) { return; }
-        if (dist_idx >= maxDistinctClasses) {
-            throw OsmtInternalException();
-        }
         dist_classes.insert(tr_d, dist_idx);
         assert(index_to_dist.size_() == dist_idx);
         index_to_dist.push(tr_d);
@@ -4,6 +4,8 @@
 
 #include "Explainer.h"
 #include "UFInterpolator.h"
+
+#include <numeric>
 //=============================================================================
 // Explanation Routines: details about these routines are in paper
 //
@@ -100,7 +102,7 @@ vec<PtAsgn> Explainer::explain(opensmt::pair<ERef,ERef> nodePair) {
     congruences.clear();
 #endif
 
-    DupChecker dupChecker(dcd);
+    DupChecker dupChecker(dcd, logic);
     vec<PtAsgn> explanation;
     PendingQueue exp_pending;
     exp_pending.push(nodePair);
@@ -130,7 +132,91 @@ vec<PtAsgn> Explainer::explain(opensmt::pair<ERef,ERef> nodePair) {
 //
 vec<PtAsgn> Explainer::explain(ERef x, ERef y)
 {
-    return explain({x, y});
+    ++stats.explanations;
+    recordEdges = minimizationLimit > 0;
+    explainedEdges.clear();
+    literalIndex.clear();
+    vec<PtAsgn> explanation = explain({x, y});
+    if (recordEdges and explanation.size() > 1 and explanation.size() <= minimizationLimit) {
+        minimize(x, y, explanation);
+    }
+    recordEdges = false;
+    return explanation;
+}
+
+//
+// Drop the literals of the explanation of x = y that are not needed.  The
+// equality is checked by a congruence closure over the nodes of the edges
+// used by the explanation; a literal labelling an edge between two terms
+// whose arguments are already equal is redundant.
+//
+void Explainer::minimize(ERef x, ERef y, vec<PtAsgn> & explanation) {
+    std::unordered_map<ERef, int, ERefHash> nodeIndex;
+    for (auto const & edge : explainedEdges) {
+        nodeIndex.emplace(edge.from, nodeIndex.size());
+        nodeIndex.emplace(edge.to, nodeIndex.size());
+    }
+    std::vector<int> parent(nodeIndex.size());
+    auto find = [&parent](int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    auto same = [&](ERef a, ERef b) {
+        if (a == b) { return true; }
+        auto ia = nodeIndex.find(a);
+        auto ib = nodeIndex.find(b);
+        return ia != nodeIndex.end() and ib != nodeIndex.end() and find(ia->second) == find(ib->second);
+    };
+    auto argumentsEqual = [&](ERef a, ERef b) {
+        Enode const & na = getEnode(a);
+        Enode const & nb = getEnode(b);
+        // Anonymous enodes have no arguments
+        if (na.getSymbol() != nb.getSymbol() or na.getSize() != nb.getSize() or na.getSize() == 0) { return false; }
+        for (uint32_t i = 0; i < na.getSize(); ++i) {
+            if (not same(na[i], nb[i])) { return false; }
+        }
+        return true;
+    };
+    std::vector<bool> active(explanation.size(), true);
+    auto follows = [&]() {
+        std::iota(parent.begin(), parent.end(), 0);
+        for (bool changed = true; changed; ) {
+            changed = false;
+            for (auto const & edge : explainedEdges) {
+                int a = find(nodeIndex[edge.from]);
+                int b = find(nodeIndex[edge.to]);
+                if (a != b and ((edge.literal >= 0 and active[edge.literal]) or argumentsEqual(edge.from, edge.to))) {
+                    parent[a] = b;
+                    changed = true;
+                }
+            }
+        }
+        return same(x, y);
+    };
+
+    for (int i = explanation.size() - 1; i >= 0; --i) {
+        active[i] = false;
+        if (follows()) {
+            ++stats.minimizedLiterals;
+        } else {
+            active[i] = true;
+        }
+    }
+    int j = 0;
+    for (int i = 0; i < explanation.size(); ++i) {
+        if (active[i]) {
+            explanation[j++] = explanation[i];
+        }
+    }
+    explanation.shrink(explanation.size() - j);
+}
+
+void Explainer::Stats::printStatistics(std::ostream & os) const {
+    os << "; explanations.............: " << explanations << '\n';
+    os << "; minimized literals.......: " << minimizedLiterals << '\n';
 }
 
 void Explainer::cleanup() {
@@ -154,6 +240,13 @@ void Explainer::explainAlongPath(ERef x, ERef y, vec<PtAsgn> &outExplanation, Pe
         ERef p = getEnode(v).getExpParent();
         assert(p != ERef_Undef);
         PtAsgn edgeExplanation = explainEdge(v, p, pendingExplanations, dc);
+        if (recordEdges) {
+            PTRef reason = getEnode(v).getExpReason().tr;
+            if (edgeExplanation != PtAsgn_Undef) {
+                literalIndex.emplace(reason, outExplanation.size());
+            }
+            explainedEdges.push_back({v, p, reason == PTRef_Undef ? -1 : literalIndex.at(reason)});
+        }
         if (edgeExplanation != PtAsgn_Undef) {
             outExplanation.push(edgeExplanation);
         }
@@ -7,7 +7,10 @@
 
 #include "EnodeStore.h"
 #include "UFInterpolator.h"
+
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 class Explainer {
 protected:
@@ -16,28 +19,38 @@ protected:
     //
     struct DupChecker;
     class DuplicateCheckerData {
-        Map<PTRef,int,PTRefHash>    duplicates;                       // Fast duplicate checking
-        int                         dup_count = 0;                    // Current dup token
+        std::vector<uint32_t>       duplicates;                       // Fast duplicate checking, indexed by term id
+        uint32_t                    dup_count = 0;                    // Current dup token
         bool                        free = true;
         friend                      struct DupChecker;
     };
 
     struct DupChecker {
         DuplicateCheckerData &dc;
-        DupChecker(DuplicateCheckerData &dc) : dc(dc) {
+        Logic const & logic;
+        DupChecker(DuplicateCheckerData &dc, Logic const & logic) : dc(dc), logic(logic) {
             if (!dc.free) {
                 throw OsmtInternalException(); // "Attempt to re-use DuplicateChecker without releasing"
             }
             dc.free = false;
-            if (dc.dup_count < std::numeric_limits<int>::max()) {
+            if (dc.dup_count < std::numeric_limits<uint32_t>::max()) {
                 ++dc.dup_count;
             } else {
-                dc.duplicates.clear();
-                dc.dup_count = 0;
+                std::fill(dc.duplicates.begin(), dc.duplicates.end(), 0);
+                dc.dup_count = 1;
             }
         }
-        inline void storeDup(PTRef e) { assert(!dc.free); if (dc.duplicates.has(e)) dc.duplicates[e] = dc.dup_count; else dc.duplicates.insert(e, dc.dup_count); }
-        inline bool isDup   (PTRef e) { assert(!dc.free); return !dc.duplicates.has(e) ? false : dc.duplicates[e] == dc.dup_count; }
+        inline void storeDup(PTRef e) {
+            assert(!dc.free);
+            uint32_t id = Idx(logic.getPterm(e).getId());
+            if (id >= dc.duplicates.size()) { dc.duplicates.resize(id + 1, 0); }
+            dc.duplicates[id] = dc.dup_count;
+        }
+        inline bool isDup(PTRef e) const {
+            assert(!dc.free);
+            uint32_t id = Idx(logic.getPterm(e).getId());
+            return id < dc.duplicates.size() and dc.duplicates[id] == dc.dup_count;
+        }
         ~DupChecker() {
             dc.free = true;
         }
@@ -46,6 +59,7 @@ protected:
     DuplicateCheckerData dcd;
 
     EnodeStore & store;
+    Logic const & logic;
 
     Enode const & getEnode(ERef ref) const { return store[ref]; }
     Enode & getEnode(ERef ref) { return store[ref]; }
@@ -74,14 +88,42 @@ protected:
     int             time_stamp = 0;                   // Need for finding NCA
 
     vec<opensmt::pair<PTRef,PTRef>> congruences;
+
+    //
+    // Explanation minimisation.  The edges of the proof forest used by an explanation are
+    // recorded, and a literal is dropped if the equality still follows from the remaining
+    // ones by congruence over the recorded nodes.
+    //
+    struct ExplainedEdge {
+        ERef from;
+        ERef to;
+        int literal;                                  // Index of the literal in the explanation, -1 for a congruence edge
+    };
+    int minimizationLimit = 0;                        // Largest explanation to minimise, 0 disables minimisation
+    bool recordEdges = false;
+    std::vector<ExplainedEdge> explainedEdges;
+    std::unordered_map<PTRef, int, PTRefHash> literalIndex;
+    void minimize(ERef x, ERef y, vec<PtAsgn> & explanation);
+
 public:
-    Explainer(EnodeStore & store) : store(store) {}
+    struct Stats {
+        int explanations = 0;
+        int minimizedLiterals = 0;
+        void printStatistics(std::ostream & os) const;
+    };
+
+    Explainer(EnodeStore & store, Logic const & logic) : store(store), logic(logic) {}
     virtual ~Explainer() = default;
 
     void                storeExplanation    (ERef, ERef, PtAsgn);        // Store the explanation for the merge
     void                removeExplanation   ();                          // Undoes the effect of storeExplanation
     virtual vec<PtAsgn> explain             (ERef, ERef);                // Return explanation of why the given two terms are equal
     const vec<opensmt::pair<PTRef,PTRef>> &getCongruences() const { return congruences; }
+    void                setMinimizationLimit(int limit) { minimizationLimit = limit; }
+    Stats const &       getStats() const { return stats; }
+
+protected:
+    Stats stats;
 };
 
 class InterpolatingExplainer : public Explainer {
@@ -90,7 +132,7 @@ protected:
 
     virtual PtAsgn explainEdge (ERef, ERef, PendingQueue &exp_pending, DupChecker& dc) override;
 public:
-    InterpolatingExplainer(EnodeStore & store) : Explainer(store) {}
+    InterpolatingExplainer(EnodeStore & store, Logic const & logic) : Explainer(store, logic) {}
 
     virtual vec<PtAsgn> explain     (ERef, ERef) override;
     std::unique_ptr<CGraph> getCGraph() { return std::move(cgraph); }
@@ -29,7 +29,7 @@ using namespace opensmt;
 using matrix_t = std::vector<std::vector<Real>>;
 
 // initializing static member
-DecomposedStatistics FarkasInterpolator::stats {};
+thread_local DecomposedStatistics FarkasInterpolator::stats {};
 
 namespace {
 
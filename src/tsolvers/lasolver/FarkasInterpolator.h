@@ -72,7 +72,7 @@ public:
     PTRef getDecomposedInterpolant();
     PTRef getDualDecomposedInterpolant();
 
-    static DecomposedStatistics stats;
+    static thread_local DecomposedStatistics stats;
 
 private:
 
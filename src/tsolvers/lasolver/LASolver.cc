@@ -4,6 +4,7 @@
 #include "LA.h"
 #include "ModelBuilder.h"
 #include "LIAInterpolator.h"
+#include "Matrix.h"
 
 static SolverDescr descr_la_solver("LA Solver", "Solver for Quantifier Free Linear Arithmetics");
 
@@ -93,9 +94,14 @@ LASolver::LASolver(SolverDescr dls, SMTConfig & c, ArithLogic & l)
         , laVarMapper(l)
         , boundStore(laVarStore)
         , simplex(boundStore)
+        , cutBudget(c.lia_cut_budget())
+        , integerChecks(0)
+        , propagationRowSize(c.lra_propagation_row_size())
 {
     dec_limit.push(0);
     status = INIT;
+    simplex.setPivotingRule(c.lra_devex_pivoting() ? Simplex::PivotingRule::Devex : Simplex::PivotingRule::ShortestRow,
+                            c.lra_bland_threshold());
 }
 
 
@@ -126,6 +132,12 @@ void LASolver::clearSolver()
 
     int_vars.clear();
     int_vars_map.clear();
+    cutBudget = config.lia_cut_budget();
+    integerChecks = 0;
+    propagationRows.clear();
+    rowsOfVar.clear();
+    rowDeductionReasons.clear();
+    propagationRowSize = config.lra_propagation_row_size();
     // TODO: clear statistics
 //    this->egraphStats.clear();
 }
@@ -308,6 +320,7 @@ LVRef LASolver::exprToLVar(PTRef expr) {
             // MB: Notify must be called before the query isIntVar!
             isInt &= isIntVar(term.var) && term.coeff.isInteger();
         }
+        addPropagationRow(x, *poly);
         simplex.newRow(x, std::move(poly));
         if (isInt) {
             markVarAsInt(x);
@@ -344,6 +357,14 @@ void LASolver::declareAtom(PTRef leq_tr)
     setKnown(leq_tr);
 }
 
+namespace {
+constexpr int cutPeriod = 4; // Complete checks per round of cuts
+// Larger systems are left to branch-and-bound, the normal form would cost more than the split saves
+constexpr int maxCutFromProofDimension = 50;
+// Cuts with larger coefficients slow down the simplex more than they help
+opensmt::Real const maxCutCoefficient = 1000000;
+}
+
 LVRef LASolver::splitOnMostInfeasible(vec<LVRef> const & varsToFix) const {
     opensmt::Real maxDistance = 0;
     LVRef chosen = LVRef_Undef;
@@ -377,6 +398,18 @@ TRes LASolver::checkIntegersAndSplit() {
         return TRes::SAT;
     }
 
+    // Cutting on every check makes branch-and-bound chase the cuts, so the two are interleaved
+    if (cutsEnabled() and ++integerChecks % cutPeriod == 0) {
+        bool cut = addCutFromProof();
+        for (int i = 0; i < varsToFix.size() and not cut and cutsEnabled(); i++) {
+            cut = addGomoryCut(varsToFix[i]);
+        }
+        if (cut) {
+            setStatus(NEWSPLIT);
+            return TRes::SAT;
+        }
+    }
+
     LVRef chosen = splitOnMostInfeasible(varsToFix);
 
     assert(chosen != LVRef_Undef);
@@ -388,10 +421,178 @@ TRes LASolver::checkIntegersAndSplit() {
     PTRef constr = logic.mkOr(upperBound, lowerBound);
 
     splitondemand.push(constr);
+    laSolverStats.num_branches++;
     setStatus(NEWSPLIT);
     return TRes::SAT;
 }
 
+bool LASolver::cutsEnabled() const {
+    // The cuts mix the variables of different partitions
+    return cutBudget > 0 and not config.produce_inter();
+}
+
+std::unique_ptr<Polynomial> LASolver::getDefinition(LVRef v) {
+    if (isProblemVar(v)) {
+        auto poly = std::make_unique<Polynomial>();
+        poly->addTerm(v, 1);
+        return poly;
+    }
+    return expressionToLVarPoly(getVarPTRef(v));
+}
+
+PTRef LASolver::mkSum(IntTerms const & terms) {
+    vec<PTRef> args;
+    for (auto const & [var, coeff] : terms) {
+        assert(coeff.isInteger());
+        args.push(logic.mkTimes(getVarPTRef(var), logic.mkIntConst(coeff)));
+    }
+    return logic.mkPlus(std::move(args));
+}
+
+/**
+ * Computes the Hermite normal form H = A*R^-1 of the system A*x = b of the constraints tight in the current
+ * solution.  With z = R*x the system reads H*z = b, and since R is unimodular, z is integral if and only if x is.
+ * H is lower triangular, so z is obtained by forward substitution.  If some z_i is not an integer, the current
+ * solution is cut off by branching on R_i*x <= floor(z_i) or R_i*x >= floor(z_i) + 1.
+ */
+bool LASolver::addCutFromProof() {
+    std::vector<LVRef> tight;
+    for (LVRef v : laVarStore) {
+        if (not isIntVar(v) or not simplex.isProcessedByTableau(v)) { continue; }
+        bool hasLower = simplex.hasLBound(v);
+        bool hasUpper = simplex.hasUBound(v);
+        if (not hasLower and not hasUpper) { continue; }
+        Delta val = simplex.getValuation(v);
+        if (not val.hasDelta() and ((hasLower and simplex.Lb(v) == val) or (hasUpper and simplex.Ub(v) == val))) {
+            tight.push_back(v);
+        }
+    }
+    if (tight.empty() or tight.size() > static_cast<std::size_t>(maxCutFromProofDimension)) { return false; }
+
+    std::vector<std::unique_ptr<Polynomial>> rows;
+    std::vector<LVRef> columns;
+    std::unordered_map<unsigned, int> columnOf;
+    for (LVRef v : tight) {
+        rows.push_back(getDefinition(v));
+        for (auto const & term : *rows.back()) {
+            if (columnOf.find(term.var.x) == columnOf.end()) {
+                columnOf.emplace(term.var.x, static_cast<int>(columns.size()) + 1);
+                columns.push_back(term.var);
+            }
+        }
+    }
+    int m = static_cast<int>(rows.size());
+    int n = static_cast<int>(columns.size());
+    if (n > maxCutFromProofDimension) { return false; }
+
+    LAVecAllocator va;
+    LAVecStore vecStore(va);
+    LAMatrixStore ms(vecStore);
+    MId A = ms.getNewMatrix(m, n);
+    for (int i = 0; i < m; i++) {
+        for (auto const & term : *rows[i]) {
+            ms.MM(A, i + 1, columnOf[term.var.x]) = term.coeff;
+        }
+    }
+    MId H = ms.getNewMatrix(m, n);
+    MId R = ms.getNewMatrix(n, n);
+    MId Ri = MId_Undef;
+    int dim;
+    ms.compute_hnf_v1(A, H, dim, R, Ri);
+
+    std::vector<opensmt::Real> z;
+    for (int i = 1, col = 1; i <= m and col <= dim; i++) {
+        if (ms.MM(H, i, col) == 0) { continue; } // Linearly dependent on the previous rows
+        opensmt::Real val = simplex.getValuation(tight[i - 1]).R();
+        for (int j = 1; j < col; j++) {
+            val -= ms.MM(H, i, j) * z[j - 1];
+        }
+        val /= ms.MM(H, i, col);
+        if (not val.isInteger()) {
+            IntTerms terms;
+            for (int j = 1; j <= n; j++) {
+                opensmt::Real const & coeff = ms.MM(R, col, j);
+                if (coeff == 0) { continue; }
+                if (cmpabs(coeff, maxCutCoefficient) > 0) { return false; }
+                terms.emplace_back(columns[j - 1], coeff);
+            }
+            PTRef sum = mkSum(terms);
+            opensmt::Real lower = val.floor();
+            PTRef upperBound = logic.mkLeq(sum, logic.mkIntConst(lower));
+            PTRef lowerBound = logic.mkGeq(sum, logic.mkIntConst(lower + 1));
+            if (hasPolarity(upperBound) or hasPolarity(lowerBound)) { return false; }
+            PTRef constr = logic.mkOr(upperBound, lowerBound);
+            if (not logic.isOr(constr)) { return false; }
+            splitondemand.push(constr);
+            laSolverStats.num_cuts_from_proofs++;
+            cutBudget--;
+            return true;
+        }
+        z.push_back(std::move(val));
+        col++;
+    }
+    return false;
+}
+
+/**
+ * With the nonbasic variables at their bounds, the row of basicVar can be written as basicVar = c + sum a_j*y_j,
+ * where y_j = x_j - l_j or y_j = u_j - x_j is non-negative.  The value c of basicVar is not an integer, and the
+ * Gomory mixed-integer cut sum g_j*y_j >= 1 holds for every solution where basicVar and the integer x_j are integral.
+ * The cut is added as a clause together with the negation of the bounds it depends on.
+ */
+bool LASolver::addGomoryCut(LVRef basicVar) {
+    if (not simplex.isBasic(basicVar)) { return false; }
+    Delta basicVal = simplex.getValuation(basicVar);
+    assert(not basicVal.hasDelta());
+    opensmt::Real f0 = basicVal.R() - basicVal.R().floor();
+    assert(f0 > 0);
+    opensmt::Real f0c = opensmt::Real(1) - f0;
+
+    vec<PTRef> clause;
+    IntTerms terms;
+    opensmt::Real rhs = 1;
+    for (auto const & term : simplex.getRowPoly(basicVar)) {
+        LVRef x = term.var;
+        Delta val = simplex.getValuation(x);
+        if (val.hasDelta()) { return false; }
+        bool atLower = simplex.hasLBound(x) and simplex.Lb(x) == val;
+        if (not atLower and not (simplex.hasUBound(x) and simplex.Ub(x) == val)) { return false; }
+        opensmt::Real a = atLower ? term.coeff : -term.coeff;
+        opensmt::Real g;
+        if (isIntVar(x)) {
+            opensmt::Real fj = a - a.floor();
+            if (fj == 0) { continue; }
+            g = fj <= f0 ? fj / f0 : (opensmt::Real(1) - fj) / f0c;
+        } else {
+            g = a > 0 ? a / f0 : -a / f0c;
+        }
+        // g*y = g*x - g*l if at lower bound, and -g*x + g*u if at upper bound
+        rhs += g * val.R() * (atLower ? 1 : -1);
+        terms.emplace_back(x, atLower ? g : -g);
+        PtAsgn bound = getAsgnByBound(atLower ? simplex.readLBoundRef(x) : simplex.readUBoundRef(x));
+        clause.push(bound.sgn == l_True ? logic.mkNot(bound.tr) : bound.tr);
+    }
+    if (terms.empty()) { return false; }
+
+    opensmt::Real den = rhs.get_den();
+    for (auto const & term : terms) {
+        den = lcm(den, term.second.get_den());
+    }
+    for (auto & term : terms) {
+        term.second *= den;
+        if (cmpabs(term.second, maxCutCoefficient) > 0) { return false; }
+    }
+    PTRef cut = logic.mkGeq(mkSum(terms), logic.mkIntConst(rhs * den));
+    if (logic.isTrue(cut) or logic.isFalse(cut) or hasPolarity(cut)) { return false; }
+    clause.push(cut);
+    PTRef constr = logic.mkOr(std::move(clause));
+    if (not logic.isOr(constr)) { return false; }
+    splitondemand.push(constr);
+    laSolverStats.num_gomory_cuts++;
+    cutBudget--;
+    return true;
+}
+
 void LASolver::getNewSplits(vec<PTRef>& splits) {
     splitondemand.copyTo(splits);
     splitondemand.clear();
@@ -458,6 +659,7 @@ bool LASolver::assertLit(PtAsgn asgn)
         setPolarity(asgn.tr, asgn.sgn);
         pushDecision(asgn);
         getSimpleDeductions(it, bound_ref);
+        getRowDeductions(it, bound_ref);
         generalTSolverStats.sat_calls++;
     } else {
         generalTSolverStats.unsat_calls++;
@@ -530,6 +732,11 @@ void LASolver::popBacktrackPoints(unsigned int count) {
             LVRef it = getVarForLeq(dec.tr);
             simplex.boundDeactivated(it);
         }
+        if (not rowDeductionReasons.empty()) {
+            for (auto i = deductions_lim.last(); i < th_deductions.size_(); i++) {
+                rowDeductionReasons.erase(th_deductions[i].tr);
+            }
+        }
 
         TSolver::popBacktrackPoint();
     }
@@ -647,6 +854,128 @@ void LASolver::getSimpleDeductions(LVRef v, LABoundRef br)
     }
 }
 
+void LASolver::addPropagationRow(LVRef v, Polynomial const & poly) {
+    // Deductions from rows are explained by the bounds of the row, which the interpolation does not know about
+    if (poly.size() + 1 > static_cast<std::size_t>(propagationRowSize) or config.produce_inter()) { return; }
+    auto index = static_cast<unsigned>(propagationRows.size());
+    propagationRows.push_back({v, poly});
+    auto addOccurrence = [this, index](LVRef var) {
+        if (rowsOfVar.size() <= getVarId(var)) { rowsOfVar.resize(getVarId(var) + 1); }
+        rowsOfVar[getVarId(var)].push_back(index);
+    };
+    addOccurrence(v);
+    for (auto const & term : poly) {
+        addOccurrence(term.var);
+    }
+}
+
+void LASolver::getRowDeductions(LVRef v, LABoundRef br)
+{
+    if (getVarId(v) >= rowsOfVar.size()) { return; }
+    // A bound weaker than the active one implies nothing new
+    bool isLower = boundStore[br].getType() == bound_l;
+    if ((isLower ? simplex.readLBoundRef(v) : simplex.readUBoundRef(v)) != br) { return; }
+    for (unsigned index : rowsOfVar[getVarId(v)]) {
+        PropagationRow const & row = propagationRows[index];
+        bool positive = row.var == v ? false : row.poly.getCoeff(v) > 0;
+        deduceFromRow(row, positive == isLower);
+    }
+}
+
+/**
+ * Writes the row as the sum of c_i*x_i = 0 and bounds every c_k*x_k by the sum of the bounds of the other terms.  If
+ * lower, the bounds are c_i*x_i >= lb_i and imply c_k*x_k <= -sum_{i != k} lb_i, otherwise they are c_i*x_i <= ub_i
+ * and imply c_k*x_k >= -sum_{i != k} ub_i.  The sum over all terms is computed once and the term of x_k is subtracted
+ * from it, which is only possible if all the terms are bounded or x_k is the only unbounded term.
+ */
+void LASolver::deduceFromRow(PropagationRow const & row, bool lower)
+{
+    opensmt::Real const minusOne(-1);
+    auto forEachTerm = [&](auto && visit) {
+        visit(row.var, minusOne);
+        for (auto const & term : row.poly) {
+            visit(term.var, term.coeff);
+        }
+    };
+    auto usesLower = [lower](opensmt::Real const & coeff) { return (coeff > 0) == lower; };
+    auto hasBound = [&](LVRef var, opensmt::Real const & coeff) {
+        return usesLower(coeff) ? simplex.hasLBound(var) : simplex.hasUBound(var);
+    };
+    auto contribution = [&](LVRef var, opensmt::Real const & coeff) {
+        return coeff * (usesLower(coeff) ? simplex.Lb(var) : simplex.Ub(var));
+    };
+
+    LVRef unbounded = LVRef_Undef;
+    int unboundedCount = 0;
+    forEachTerm([&](LVRef var, opensmt::Real const & coeff) {
+        if (not hasBound(var, coeff)) {
+            unbounded = var;
+            ++unboundedCount;
+        }
+    });
+    if (unboundedCount > 1) { return; }
+
+    Delta sum(0);
+    forEachTerm([&](LVRef var, opensmt::Real const & coeff) {
+        if (var != unbounded) { sum += contribution(var, coeff); }
+    });
+
+    forEachTerm([&](LVRef target, opensmt::Real const & targetCoeff) {
+        if (unbounded != LVRef_Undef and target != unbounded) { return; }
+        if (boundStore.getBounds(target).size() == 0) { return; }
+        Delta rest = unbounded == LVRef_Undef ? sum - contribution(target, targetCoeff) : sum;
+        auto implied = getImpliedBounds(target, rest / (-targetCoeff), usesLower(targetCoeff));
+        if (implied.empty()) { return; }
+        std::vector<LABoundRef> reason;
+        forEachTerm([&](LVRef var, opensmt::Real const & coeff) {
+            if (var != target) {
+                reason.push_back(usesLower(coeff) ? simplex.readLBoundRef(var) : simplex.readUBoundRef(var));
+            }
+        });
+        for (LABoundRef br : implied) {
+            PtAsgn ba = getAsgnByBound(br);
+            storeDeduction(PtAsgn_reason(ba.tr, ba.sgn, PTRef_Undef));
+            rowDeductionReasons[ba.tr] = reason;
+            ++laSolverStats.num_row_deductions;
+        }
+    });
+}
+
+std::vector<LABoundRef> LASolver::getImpliedBounds(LVRef v, Delta const & bound, bool upper)
+{
+    // No rounding for integer variables: the deduced atoms do not become active bounds, so the simplex solution must
+    // satisfy them already
+    std::vector<LABoundRef> implied;
+    auto const & bounds = boundStore.getBounds(v);
+    // The bounds are ordered by their values, so the implied ones are at the end of the list for an upper bound
+    // and at its beginning for a lower bound
+    if (upper) {
+        for (int i = bounds.size() - 1; i >= 0 and boundStore[bounds[i]].getValue() >= bound; i--) {
+            LABound const & b = boundStore[bounds[i]];
+            if (b.getType() == bound_u and not hasPolarity(getAsgnByBound(bounds[i]).tr)) { implied.push_back(bounds[i]); }
+        }
+    } else {
+        for (int i = 0; i < bounds.size() and boundStore[bounds[i]].getValue() <= bound; i++) {
+            LABound const & b = boundStore[bounds[i]];
+            if (b.getType() == bound_l and not hasPolarity(getAsgnByBound(bounds[i]).tr)) { implied.push_back(bounds[i]); }
+        }
+    }
+    return implied;
+}
+
+vec<PtAsgn> LASolver::getReasonFor(PtAsgn lit) {
+    auto it = rowDeductionReasons.find(lit.tr);
+    if (it == rowDeductionReasons.end()) {
+        return TSolver::getReasonFor(lit);
+    }
+    vec<PtAsgn> reason;
+    for (LABoundRef br : it->second) {
+        reason.push(getAsgnByBound(br));
+    }
+    reason.push(PtAsgn(lit.tr, lit.sgn == l_True ? l_False : l_True));
+    return reason;
+}
+
 void LASolver::deduce(LABoundRef bound_prop) {
     PtAsgn ba = getAsgnByBound(bound_prop);
     if (!hasPolarity(ba.tr)) {
@@ -720,6 +1049,21 @@ void LASolver::computeModel()
     }
 }
 
+std::vector<std::pair<PTRef, opensmt::Real>> LASolver::getModelValues(vec<PTRef> const & terms)
+{
+    assert( status == SAT );
+    std::vector<std::pair<PTRef, opensmt::Real>> values;
+    opensmt::Real delta = simplex.computeDelta();
+    for (PTRef term : terms) {
+        if (logic.isNumConst(term)) {
+            values.emplace_back(term, logic.getNumConst(term));
+        } else if (hasVar(term)) {
+            Delta val = simplex.getValuation(getVarForTerm(term));
+            values.emplace_back(term, val.R() + val.D() * delta);
+        }
+    }
+    return values;
+}
 
 LASolver::~LASolver( )
 {
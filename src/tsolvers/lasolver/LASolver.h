@@ -14,6 +14,8 @@
 #include "FarkasInterpolator.h"
 
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include "LAVarMapper.h"
 
 class LAVarStore;
@@ -24,12 +26,20 @@ class LASolverStats
 {
     public:
         int num_vars;
+        int num_branches;
+        int num_gomory_cuts;
+        int num_cuts_from_proofs;
+        int num_row_deductions;
         opensmt::OSMTTimeVal timer;
 
-        LASolverStats() : num_vars(0) {}
+        LASolverStats() : num_vars(0), num_branches(0), num_gomory_cuts(0), num_cuts_from_proofs(0), num_row_deductions(0) {}
 
         void printStatistics(ostream& os) {
             os << "; Number of LA vars........: " << num_vars << '\n';
+            os << "; Branches on integers.....: " << num_branches << '\n';
+            os << "; Gomory cuts..............: " << num_gomory_cuts << '\n';
+            os << "; Cuts from proofs.........: " << num_cuts_from_proofs << '\n';
+            os << "; Deductions from rows.....: " << num_row_deductions << '\n';
             os << "; LA time..................: " << timer.getTime() << " s\n";
         }
 };
@@ -110,10 +120,14 @@ public:
 
     // Return the conflicting bounds
     void getConflict(vec<PtAsgn> &) override;
+    vec<PtAsgn> getReasonFor(PtAsgn lit) override;
 
     ArithLogic& getLogic() override;
     bool        isValid(PTRef tr) override;
 
+    // The values of the given terms in a model of the current constraints, skipping the terms unknown to the solver
+    std::vector<std::pair<PTRef, opensmt::Real>> getModelValues(vec<PTRef> const & terms);
+
 
 private:
 
@@ -146,10 +160,33 @@ private:
     // Most-infeasible branching heuristic
     LVRef splitOnMostInfeasible(vec<LVRef> const &) const;
     TRes checkIntegersAndSplit();
+
+    // Cutting planes.  Both kinds are handed to the SAT solver as split clauses
+    using IntTerms = std::vector<std::pair<LVRef, opensmt::Real>>;
+    int cutBudget;                                          // Number of cuts the solver may still derive
+    int integerChecks;                                      // Number of complete checks that found a non-integral solution
+    bool cutsEnabled() const;
+    bool addCutFromProof();                                 // Branch on a combination of the tight constraints that cannot be integral (Dillig, Dillig & Aiken, CAV 2009)
+    bool addGomoryCut(LVRef basicVar);                      // Gomory mixed-integer cut from the row of a basic variable with a fractional value
+    std::unique_ptr<Polynomial> getDefinition(LVRef v);     // v as a polynomial over the problem variables
+    bool isProblemVar(LVRef v) const { return logic.isNumVarOrIte(getVarPTRef(v)); }
+    PTRef mkSum(IntTerms const & terms);
     bool isModelInteger (LVRef v) const;
 
     void getSuggestions( vec<PTRef>& dst, SolverId solver_id );                                   // find possible suggested atoms
     void getSimpleDeductions(LVRef v, LABoundRef);      // find deductions from actual bounds position
+
+    // Bound propagation over the rows defining the slack variables.  The rows never change, unlike the rows of the
+    // tableau, and they also cover the slack variables without active bounds, which the tableau keeps out of its columns
+    struct PropagationRow { LVRef var; Polynomial poly; };  // var = poly
+    std::vector<PropagationRow> propagationRows;
+    std::vector<std::vector<unsigned>> rowsOfVar;           // Indices of the propagation rows containing the var
+    std::unordered_map<PTRef, std::vector<LABoundRef>, PTRefHash> rowDeductionReasons; // The active bounds implying a deduced atom
+    int propagationRowSize;
+    void addPropagationRow(LVRef v, Polynomial const & poly);
+    void getRowDeductions(LVRef v, LABoundRef);             // find deductions from the rows containing v after its bound changed
+    void deduceFromRow(PropagationRow const & row, bool lower);
+    std::vector<LABoundRef> getImpliedBounds(LVRef v, Delta const & bound, bool upper); // The unassigned bounds of v implied by bound
     unsigned getIteratorByPTRef( PTRef e, bool );                                                 // find bound iterator by the PTRef
     inline bool getStatus( );                               // Read the status of the solver in lbool
     bool setStatus( LASolverStatus );               // Sets and return status of the solver
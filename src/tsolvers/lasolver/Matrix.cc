@@ -97,8 +97,8 @@ LAMatrixStore::addmul_column(MId A, int j, int jpivot, const opensmt::Real& x)
 void
 LAMatrixStore::addmul_row(MId A, int i, int ipivot, const opensmt::Real& x)
 {
-    std::string s = x.get_str();
 #ifdef ENABLE_MATRIX_TRACE
+    string s = x.get_str();
     printf("addmul_row i = %d, ipivot = %d, x = %s\n", i, ipivot, s.c_str());
 #endif
     assert(x.isInteger());
@@ -524,7 +524,7 @@ LAMatrixStore::compute_hnf_v1(const MId U1, MId &H, int &dim1, MId &R1, MId &Ri1
     LAMatrix& Hm = operator[](H);
     LAMatrix& U1m = operator[](U1);
     if (R1 != MId_Undef) {
-        assert(operator[](R1).nRows() == U1m.nRows());
+        assert(operator[](R1).nRows() == U1m.nCols());
     }
 
     if (H != U1)
@@ -9,6 +9,8 @@
 #include <Vec.h>
 #include <Alloc.h>
 #include "ArithLogic.h"
+
+#include <memory>
 //
 // Class to store the term of constraints as a column of Simplex method tableau
 //
@@ -33,6 +35,13 @@ public:
             new (&args[i]) opensmt::Real(ps[i]);
         }
     }
+    // Destroys the elements; the memory itself is owned by the allocator
+    void destroy() {
+        for (int i = 0; i < size(); i++) {
+            std::destroy_at(&args[i]);
+        }
+        std::destroy_at(&den);
+    }
     int size() const { return header.size; }
     opensmt::Real& operator[] (int i) { assert(i >= 1); assert(i <= size()); return args[i-1]; }
     const opensmt::Real& operator[] (int i) const { assert( i >= 1 && i <= size()); return args[i-1]; }
@@ -59,16 +68,19 @@ class LAVecAllocator : public RegionAllocator<uint32_t>
         return (sizeof(LAVec) + (sizeof(opensmt::Real) * sz)) / sizeof(uint32_t); }
 private:
     vec<LAVecRef>   lavecs;
+    void destroyVecs() { for (LAVecRef r : lavecs) { lea(r)->destroy(); } }
 public:
-    inline void   clear() override { lavecs.clear(); RegionAllocator::clear(); }
+    inline void   clear() override { destroyVecs(); lavecs.clear(); RegionAllocator::clear(); }
     LAVecAllocator(uint32_t start_cap) : RegionAllocator<uint32_t>(start_cap), n_vecs(0) {}
     LAVecAllocator()                   : n_vecs(0) {}
+    ~LAVecAllocator() { destroyVecs(); }
     unsigned getNumVecs() const { return n_vecs; };
 
     LAVecRef alloc(std::vector<opensmt::Real>&& ps, const opensmt::Real& den) {
         uint32_t v = RegionAllocator<uint32_t>::alloc(lavecWord32Size(ps.size()));
         LAVecRef vid = {v};
         new (lea(vid)) LAVec(std::move(ps), den);
+        lavecs.push(vid);
         n_vecs++;
         return vid;
     }
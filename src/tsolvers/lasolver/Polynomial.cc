@@ -9,43 +9,44 @@
 
 void Polynomial::addTerm(LVRef var, opensmt::Real coeff) {
     assert(!contains(var));
-    Term term {var, std::move(coeff)};
-    auto it = std::upper_bound(poly.begin(), poly.end(), term, TermCmp{});
-    poly.insert(it, std::move(term));
+    auto it = std::upper_bound(vars.begin(), vars.end(), var, [](LVRef a, LVRef b) { return a.x < b.x; });
+    coeffs.insert(coeffs.begin() + (it - vars.begin()), std::move(coeff));
+    vars.insert(it, var);
 }
 
 unsigned long Polynomial::size() const {
-    return poly.size();
+    return vars.size();
 }
 
 const FastRational &Polynomial::getCoeff(LVRef var) const {
     assert(contains(var));
-    return findTermForVar(var)->coeff;
+    return coeffs[indexOf(var)];
 }
 
 opensmt::Real Polynomial::removeVar(LVRef var) {
     assert(contains(var));
-    iterator it = findTermForVar(var);
-    auto coeff = std::move(it->coeff);
-    poly.erase(it);
+    auto index = indexOf(var);
+    auto coeff = std::move(coeffs[index]);
+    vars.erase(vars.begin() + index);
+    coeffs.erase(coeffs.begin() + index);
     return coeff;
 }
 
 void Polynomial::negate() {
-    for(auto & term : poly) {
-        term.coeff.negate();
+    for(auto & coeff : coeffs) {
+        coeff.negate();
     }
 }
 
 void Polynomial::divideBy(const opensmt::Real &r) {
-    for(auto & term : poly) {
-        term.coeff /= r;
+    for(auto & coeff : coeffs) {
+        coeff /= r;
     }
 }
 
 void Polynomial::print() const {
-    for (auto & term : poly) {
+    for (auto term : *this) {
         std::cout << term.coeff << " * " << term.var.x << "v + ";
     }
     std::cout << std::endl;
-}
\ No newline at end of file
+}
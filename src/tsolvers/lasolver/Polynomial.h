@@ -7,26 +7,51 @@
 
 #include "LAVar.h"
 #include "Real.h"
+#include <algorithm>
+#include <cassert>
 #include <vector>
-#include <unordered_map>
 #include <functional>
 
 class Polynomial{
     friend class Tableau;
 private:
+    // The variables and the coefficients are stored in separate arrays ordered by variable num, so that searching for
+    // a variable and merging two polynomials only walk the contiguous variable ids.
+    std::vector<LVRef> vars;
+    std::vector<opensmt::Real> coeffs;
+
+    std::size_t indexOf(LVRef var) const {
+        auto it = std::lower_bound(vars.begin(), vars.end(), var, [](LVRef a, LVRef b) { return a.x < b.x; });
+        return it != vars.end() && *it == var ? it - vars.begin() : vars.size();
+    }
+
+public:
     struct Term {
         LVRef var;
-        opensmt::Real coeff;
-
-        Term(LVRef var, opensmt::Real&& coeff): var{var.x}, coeff{std::move(coeff)} {}
+        opensmt::Real & coeff;
     };
-    struct TermCmp {
-        bool operator()(const Term& first, const Term& second) { return first.var.x < second.var.x; }
+    struct ConstTerm {
+        LVRef var;
+        opensmt::Real const & coeff;
     };
-//    using poly_t = std::unordered_map<LVRef, opensmt::Real, LVRefHash>;
-    using poly_t = std::vector<Term>; // Terms are ordered by variable num
-    poly_t poly;
-public:
+
+    template<typename PolyT, typename TermT>
+    class TermIterator {
+        PolyT * poly;
+        std::size_t index;
+    public:
+        struct TermPtr {
+            TermT term;
+            TermT const * operator->() const { return &term; }
+        };
+        TermIterator(PolyT * poly, std::size_t index) : poly(poly), index(index) {}
+        TermT operator*() const { return TermT{poly->vars[index], poly->coeffs[index]}; }
+        TermPtr operator->() const { return TermPtr{**this}; }
+        TermIterator & operator++() { ++index; return *this; }
+        bool operator==(TermIterator const & other) const { return index == other.index; }
+        bool operator!=(TermIterator const & other) const { return index != other.index; }
+    };
+
     void addTerm(LVRef var, opensmt::Real coeff);
     std::size_t size() const;
     const opensmt::Real & getCoeff(LVRef var) const;
@@ -34,129 +59,117 @@ public:
     void negate();
     void divideBy(const opensmt::Real& r);
 
+    // this += coeff * other; reports the variables that appear or disappear
     template<typename ADD, typename REM>
-    void merge(const Polynomial & other, const opensmt::Real & coeff, ADD informAdded, REM informRemoved) {
-        std::vector<Term> storage;
-        merge(other, coeff, informAdded, informRemoved, storage);
-    }
-
-    template<typename ADD, typename REM>
-    void merge(const Polynomial & other, const opensmt::Real & coeff, ADD informAdded, REM informRemoved,
-            std::vector<Term>& storage);
+    void merge(const Polynomial & other, const opensmt::Real & coeff, ADD informAdded, REM informRemoved);
 
-    using iterator = poly_t::iterator;
-    using const_iterator = poly_t::const_iterator;
+    using iterator = TermIterator<Polynomial, Term>;
+    using const_iterator = TermIterator<Polynomial const, ConstTerm>;
 
     iterator begin(){
-        return poly.begin();
+        return {this, 0};
     }
     iterator end() {
-        return poly.end();
+        return {this, vars.size()};
     }
 
     const_iterator begin() const {
-        return poly.cbegin();
+        return {this, 0};
     }
     const_iterator end() const{
-        return poly.cend();
+        return {this, vars.size()};
     }
 
     // debug
     bool contains(LVRef var) const {
-        return findTermForVar(var) != poly.end();
+        return indexOf(var) != vars.size();
     }
 
 
     const_iterator findTermForVar(LVRef var) const {
-        return std::find_if(poly.begin(), poly.end(), [var](const Term& term) { return term.var == var; });
+        return {this, indexOf(var)};
     }
 
     iterator findTermForVar(LVRef var) {
-        return std::find_if(poly.begin(), poly.end(), [var](const Term& term) { return term.var == var; });
+        return {this, indexOf(var)};
     }
 
     void print() const;
 };
 
 template<typename ADD, typename REM>
-void Polynomial::merge(const Polynomial &other, const opensmt::Real &coeff, ADD informAdded,
-                  REM informRemoved, std::vector<Term>& storage) {
-    if (storage.size() < this->poly.size() + other.poly.size()) {
-        storage.resize(this->poly.size() + other.poly.size(), Term(LVRef_Undef, 0));
+void Polynomial::merge(const Polynomial &other, const opensmt::Real &coeff, ADD informAdded, REM informRemoved) {
+    // The terms are merged in place from the back, so that the terms in front of the first new variable are not
+    // touched at all and no other storage is needed.
+    std::size_t const mySize = vars.size();
+    std::size_t const otherSize = other.vars.size();
+    std::size_t added = 0;
+    {
+        std::size_t myIndex = 0;
+        std::size_t otherIndex = 0;
+        while (myIndex != mySize && otherIndex != otherSize) {
+            auto myVar = vars[myIndex].x;
+            auto otherVar = other.vars[otherIndex].x;
+            myIndex += myVar <= otherVar;
+            added += otherVar < myVar;
+            otherIndex += otherVar <= myVar;
+        }
+        added += otherSize - otherIndex;
+    }
+    std::size_t const mergedSize = mySize + added;
+    if (added > 0) {
+        vars.resize(mergedSize, LVRef_Undef);
+        coeffs.resize(mergedSize);
     }
-    std::size_t storageIndex = 0;
-    auto myIt = std::make_move_iterator(poly.begin());
-    auto otherIt = other.poly.cbegin();
-    auto myEnd = std::make_move_iterator(poly.end());
-    auto otherEnd = other.poly.cend();
-    TermCmp cmp;
-    FastRational tmp;
-    while(true) {
-        if (myIt == myEnd) {
-            for (auto it = otherIt; it != otherEnd; ++it) {
-                storage[storageIndex].var = it->var;
-                multiplication(storage[storageIndex].coeff, it->coeff, coeff);
-                ++storageIndex;
-                informAdded(it->var);
+    // Invariant: the terms of the result are in [writeIndex, mergedSize); [myIndex, writeIndex) is free
+    std::size_t myIndex = mySize;
+    std::size_t otherIndex = otherSize;
+    std::size_t writeIndex = mergedSize;
+    while (otherIndex != 0) {
+        LVRef otherVar = other.vars[otherIndex - 1];
+        if (myIndex != 0 && vars[myIndex - 1].x > otherVar.x) {
+            --myIndex;
+            --writeIndex;
+            if (writeIndex != myIndex) {
+                vars[writeIndex] = vars[myIndex];
+                coeffs[writeIndex] = std::move(coeffs[myIndex]);
             }
-            break;
-        }
-        if (otherIt == otherEnd) {
-            std::move(myIt, myEnd, storage.begin() + storageIndex);
-            storageIndex += myEnd - myIt;
-            break;
-        }
-        if (cmp(*myIt, *otherIt)) {
-            storage[storageIndex] = *myIt;
-            ++storageIndex;
-            ++myIt;
-        }
-        else if (cmp(*otherIt, *myIt)) {
-            storage[storageIndex].var = otherIt->var;
-            multiplication(storage[storageIndex].coeff, otherIt->coeff, coeff);
-            ++storageIndex;
-            informAdded(otherIt->var);
-            ++otherIt;
         }
-        else {
-            assert(myIt->var == otherIt->var);
-            multiplication(tmp, otherIt->coeff, coeff);
-            myIt->coeff += tmp;
-            if (myIt->coeff.isZero()) {
-                informRemoved(myIt->var);
+        else if (myIndex != 0 && vars[myIndex - 1] == otherVar) {
+            --myIndex;
+            --otherIndex;
+            multiplyAddAssign(coeffs[myIndex], other.coeffs[otherIndex], coeff);
+            if (coeffs[myIndex].isZero()) {
+                informRemoved(otherVar);
             }
             else {
-                storage[storageIndex] = *myIt;
-                ++storageIndex;
+                --writeIndex;
+                if (writeIndex != myIndex) {
+                    vars[writeIndex] = otherVar;
+                    coeffs[writeIndex] = std::move(coeffs[myIndex]);
+                }
             }
-            ++myIt;
-            ++otherIt;
+        }
+        else {
+            --otherIndex;
+            --writeIndex;
+            vars[writeIndex] = otherVar;
+            multiplication(coeffs[writeIndex], other.coeffs[otherIndex], coeff);
+            informAdded(otherVar);
         }
     }
-    // At this point the right elements are in `storage`, from beginning to the `storageIndex`.
-    // We need to get these elements to `this->poly`. Note that we never change the `storage` container, we just move out
-    // the appropriate elements.
-    // However, we observed that we need to shrink `poly` if its size is much smaller than the capacity.
-    // The reason is that keeping large free capacity around for many rows blows up the memory
-    // (worse case quadratic in the size of the tableau).
-    auto polySize = poly.size();
-    if (storageIndex > polySize) {
-        // In this case we have more elements to move than the current size of the `poly` container.
-        // We move the elements that fit the current `poly` size and then we insert the rest of the elements.
-        std::move(storage.begin(), storage.begin() + polySize, poly.begin());
-        poly.insert(poly.end(), std::make_move_iterator(storage.begin() + polySize), std::make_move_iterator(storage.begin() + storageIndex));
-    }
-    else if (/*storageIndex <= poly.size() and */ polySize <= 2 * storageIndex) {
-        // In this case we have less elements that need to move than what we currently already have in `poly`, but not too litle.
-        // We just move the appropriate elements and destroy the excess elements of `poly`.
-        // Since we are removing too many elements, we avoid shrinking which would require re-allocation.
-        std::move(storage.begin(), storage.begin() + storageIndex, poly.begin());
-        poly.erase(poly.begin() + storageIndex, poly.end());
-    } else { // poly.size() > 2 * storageIndex
-        // This case is similar to case 2, but we have much less elements in the result than currently in `poly`.
-        // To avoid too large free capacity in `poly`, we shrink its capacity to exactly the number of elements.
-        // It is basically `poly.shrink_to_fit()`, except that `shrink_to_fit` is non-binding.
-        std::vector<Term>(std::make_move_iterator(storage.begin()), std::make_move_iterator(storage.begin() + storageIndex)).swap(poly);
+    // The remaining terms are in [0, myIndex) already; close the gap left by the cancelled terms
+    if (writeIndex != myIndex) {
+        vars.erase(vars.begin() + myIndex, vars.begin() + writeIndex);
+        coeffs.erase(coeffs.begin() + myIndex, coeffs.begin() + writeIndex);
+        // We observed that we need to shrink the containers if their size is much smaller than the capacity.
+        // The reason is that keeping large free capacity around for many rows blows up the memory
+        // (worse case quadratic in the size of the tableau).
+        // It is basically `shrink_to_fit()`, except that `shrink_to_fit` is non-binding.
+        if (mySize > 2 * vars.size()) {
+            std::vector<LVRef>(vars.begin(), vars.end()).swap(vars);
+            std::vector<opensmt::Real>(std::make_move_iterator(coeffs.begin()), std::make_move_iterator(coeffs.end())).swap(coeffs);
+        }
     }
 }
 
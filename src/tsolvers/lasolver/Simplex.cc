@@ -30,13 +30,15 @@ Simplex::Explanation Simplex::checkSimplex() {
     processBufferOfActivatedBounds();
     bool bland_rule = false;
     unsigned repeats = 0;
+    bool const devex = pivotingRule == PivotingRule::Devex;
+    unsigned const blandBudget = blandThreshold > 0 ? blandThreshold : tableau.getNumOfCols();
 
     // keep doing pivotAndUpdate until the SAT/UNSAT status is confirmed
     while (true) {
         repeats++;
         LVRef x = LVRef_Undef;
 
-        if (!bland_rule && (repeats > tableau.getNumOfCols()))
+        if (!bland_rule && (repeats > blandBudget))
             bland_rule = true;
 
         if (bland_rule) {
@@ -44,12 +46,13 @@ Simplex::Explanation Simplex::checkSimplex() {
             ++simplex_stats.num_bland_ops;
         }
         else {
-            x = getBasicVarToFixByShortestPoly();
+            x = devex ? getBasicVarToFixByDevex() : getBasicVarToFixByShortestPoly();
             ++simplex_stats.num_pivot_ops;
         }
 
         if (x == LVRef_Undef) {
             // SAT
+            simplex_stats.checkDone(repeats - 1);
             refineBounds();
             model->saveAssignment();
             return Explanation();
@@ -60,11 +63,12 @@ Simplex::Explanation Simplex::checkSimplex() {
             y_found = findNonBasicForPivotByBland(x);
         }
         else{
-            y_found = findNonBasicForPivotByHeuristic(x);
+            y_found = devex ? findNonBasicForPivotByCost(x) : findNonBasicForPivotByHeuristic(x);
         }
         // if it was not found - UNSAT
         if (y_found == LVRef_Undef) {
             assert(isModelOutOfBounds(x));
+            simplex_stats.checkDone(repeats - 1);
             bool isOutOfLowerBound = isModelOutOfLowerBound(x);
             model->restoreAssignment();
             return getConflictingBounds(x, isOutOfLowerBound);
@@ -110,6 +114,25 @@ LVRef Simplex::getBasicVarToFixByShortestPoly() const {
     return current;
 }
 
+LVRef Simplex::getBasicVarToFixByDevex() const {
+    assert(std::all_of(candidates.begin(), candidates.end(),
+                       [&](LVRef var) {
+                           return var != LVRef_Undef && tableau.isBasic(var) && isModelOutOfBounds(var);
+                       }));
+    // The shortest row scaled by its Devex reference weight. A large weight means that the row has been obtained by
+    // pivots on small elements relative to the rest of its column, and fixing it tends to disturb many other rows.
+    LVRef current = LVRef_Undef;
+    double current_score = std::numeric_limits<double>::max();
+    for (auto it : candidates) {
+        double const score = devexWeights[getVarId(it)] * tableau.getPolySize(it);
+        if (score < current_score) {
+            current = it;
+            current_score = score;
+        }
+    }
+    return current;
+}
+
 LVRef Simplex::getBasicVarToFixByBland() const {
     assert(std::all_of(candidates.begin(), candidates.end(),
                        [&](LVRef var) {
@@ -225,6 +248,51 @@ LVRef Simplex::findNonBasicForPivotByBland(LVRef basicVar) {
     return y_found;
 }
 
+LVRef Simplex::findNonBasicForPivotByCost(LVRef basicVar) {
+    // The cost of a pivot grows with the number of rows the entering column touches, and with the complexity of the
+    // pivot element: a unit pivot element leaves the coefficients of the rows untouched by the division.
+    assert(tableau.isBasic(basicVar));
+    assert(isModelOutOfBounds(basicVar));
+    bool const increase = isModelOutOfLowerBound(basicVar);
+    LVRef v_found = LVRef_Undef;
+    std::size_t found_cost = std::numeric_limits<std::size_t>::max();
+    for (auto const & term : tableau.getRowPoly(basicVar)) {
+        auto var = term.var;
+        assert(tableau.isNonBasic(var));
+        auto const & coeff = term.coeff;
+        bool const increaseVar = increase == isPositive(coeff);
+        if (increaseVar ? !isModelStrictlyUnderUpperBound(var) : !isModelStrictlyOverLowerBound(var)) {
+            continue;
+        }
+        std::size_t const coeffCost = coeff.isOne() || (-coeff).isOne() ? 1 : (coeff.isInteger() ? 2 : 3);
+        std::size_t const cost = coeffCost * tableau.getColumn(var).size();
+        if (cost < found_cost) {
+            v_found = var;
+            found_cost = cost;
+        }
+    }
+    return v_found;
+}
+
+void Simplex::updateDevexWeights(LVRef bv, LVRef nv) {
+    // Devex reference weights of the rows (Forrest and Goldfarb), updated from the column of the entering variable
+    double const pivotCoeff = tableau.getCoeff(bv, nv).get_d();
+    double const bvWeight = devexWeights[getVarId(bv)];
+    for (LVRef row : tableau.getColumn(nv)) {
+        if (row == bv || !tableau.isBasic(row)) { continue; }
+        double const ratio = tableau.getCoeff(row, nv).get_d() / pivotCoeff;
+        double & weight = devexWeights[getVarId(row)];
+        weight = std::max(weight, ratio * ratio * bvWeight);
+    }
+    double const nvWeight = std::max(bvWeight / (pivotCoeff * pivotCoeff), 1.0);
+    devexWeights[getVarId(nv)] = nvWeight;
+    // The weights only approximate the norms with respect to the reference framework; start a new one when they grow
+    constexpr double maxWeight = 1e6;
+    if (nvWeight > maxWeight || bvWeight > maxWeight) {
+        std::fill(devexWeights.begin(), devexWeights.end(), 1.0);
+    }
+}
+
 Simplex::Explanation Simplex::assertBoundOnVar(LVRef it, LABoundRef itBound_ref) {
     assert(!model->isUnbounded(it));
     assert(boundStore[itBound_ref].getLVRef() == it);
@@ -265,6 +333,9 @@ void Simplex::pivot(const LVRef bv, const LVRef nv){
     simplex_assert(valueConsistent(bv));
 //    tableau.print();
     updateValues(bv, nv);
+    if (pivotingRule == PivotingRule::Devex) {
+        updateDevexWeights(bv, nv);
+    }
     tableau.pivot(bv, nv);
     // after pivot, bv is not longer a candidate
     eraseCandidate(bv);
@@ -356,7 +427,7 @@ bool Simplex::valueConsistent(LVRef v) const
 {
     const Delta& value = model->read(v);
     Delta sum(0);
-    for (auto & term : tableau.getRowPoly(v)){
+    for (auto const & term : tableau.getRowPoly(v)){
       sum += term.coeff * model->read(term.var);
     }
 
@@ -11,11 +11,22 @@
 #include "LRAModel.h"
 #include "SMTConfig.h"
 
+#include <algorithm>
+#include <vector>
+
 class SimplexStats {
 public:
     int num_bland_ops;
     int num_pivot_ops;
-    SimplexStats() : num_bland_ops(0), num_pivot_ops(0) {}
+    int num_checks;
+    long num_check_pivots;
+    int max_check_pivots;
+    SimplexStats() : num_bland_ops(0), num_pivot_ops(0), num_checks(0), num_check_pivots(0), max_check_pivots(0) {}
+    void checkDone(int pivots) {
+        ++num_checks;
+        num_check_pivots += pivots;
+        max_check_pivots = std::max(max_check_pivots, pivots);
+    }
     void printStatistics(ostream& os)
     {
         os << "; -------------------------" << endl;
@@ -23,6 +34,9 @@ public:
         os << "; -------------------------" << endl;
         os << "; Pivot operations.........: " << num_pivot_ops << endl;
         os << "; Bland operations.........: " << num_bland_ops << endl;
+        os << "; Checks...................: " << num_checks << endl;
+        os << "; Pivots per check.........: " << (num_checks ? double(num_check_pivots) / num_checks : 0) << endl;
+        os << "; Max pivots in a check....: " << max_check_pivots << endl;
     }
 };
 
@@ -35,8 +49,11 @@ class Simplex {
     void  pivot(LVRef basic, LVRef nonBasic);
     LVRef getBasicVarToFixByBland() const;
     LVRef getBasicVarToFixByShortestPoly() const;
+    LVRef getBasicVarToFixByDevex() const;
     LVRef findNonBasicForPivotByBland(LVRef basicVar);
     LVRef findNonBasicForPivotByHeuristic(LVRef basicVar);
+    LVRef findNonBasicForPivotByCost(LVRef basicVar);
+    void  updateDevexWeights(LVRef basic, LVRef nonBasic);
     void  updateValues(LVRef basicVar, LVRef nonBasicVar);
     inline void newCandidate(LVRef candidateVar);
     inline void eraseCandidate(LVRef candidateVar);
@@ -55,6 +72,12 @@ class Simplex {
 
     bool valueConsistent(LVRef v) const; // Debug: Checks that the value of v in the model is consistent with the evaluated value of the polynomial of v in the same model.
     bool checkTableauConsistency() const;
+public:
+    enum class PivotingRule : char { ShortestRow, Devex };
+private:
+    PivotingRule pivotingRule = PivotingRule::ShortestRow;
+    unsigned blandThreshold = 0;        // Pivots in one check before switching to Bland's rule, 0 for the number of columns
+    std::vector<double> devexWeights;   // Reference weights of the rows of basic variables for the Devex pricing
 public:
     struct ExplTerm {
         LABoundRef boundref;
@@ -68,7 +91,8 @@ public:
 
     void initModel() { model->init(); }
 
-    void clear() { model->clear(); candidates.clear(); tableau.clear(); boundsActivated.clear(); }
+    void clear() { model->clear(); candidates.clear(); tableau.clear(); boundsActivated.clear(); devexWeights.clear(); }
+    void setPivotingRule(PivotingRule rule, unsigned threshold) { pivotingRule = rule; blandThreshold = threshold; }
     Explanation checkSimplex();
     void pushBacktrackPoint() { model->pushBacktrackPoint(); }
     void popBacktrackPoint()  { model->popBacktrackPoint(); }
@@ -109,6 +133,8 @@ public:
     const Delta& Ub(LVRef v) const { return model->Ub(v); }
     bool hasLBound(LVRef v) const {return model->hasLBound(v); }
     bool hasUBound(LVRef v) const {return model->hasUBound(v); }
+    bool isBasic(LVRef v) const { return tableau.isBasic(v); }
+    const Polynomial & getRowPoly(LVRef basicVar) const { return tableau.getRowPoly(basicVar); } // basicVar = sum of the terms
 
     // Keeping track of activated bounds
 private:
@@ -121,6 +147,7 @@ private:
     void newVar(LVRef v) {
         while (getVarId(v) >= boundsActivated.size()) {
             boundsActivated.push_back(0);
+            devexWeights.push_back(1);
         }
         model->addVar(v);
         boundStore.ensureReadyFor(v);
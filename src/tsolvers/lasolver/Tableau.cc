@@ -4,6 +4,7 @@
 
 #include "Tableau.h"
 #include <iostream>
+#include <utility>
 
 #ifdef SIMPLEX_DEBUG
 #define simplex_assert(x) assert(x)
@@ -141,7 +142,7 @@ void Tableau::pivot(LVRef bv, LVRef nv) {
 
     Polynomial & nvPoly = getRowPoly(nv);
     // update column information regarding this one poly
-    for(auto & term : nvPoly) {
+    for (auto const & term : nvPoly) {
         auto var = term.var;
         assert(cols[var.x]);
         removeRowFromColumn(bv, var);
@@ -170,7 +171,6 @@ void Tableau::pivot(LVRef bv, LVRef nv) {
                        assert(contains(getColumn(removedVar), rowVar));
                        removeRowFromColumn(rowVar, removedVar);
                    }
-                   , tmp_storage
         );
     }
     assert(!cols[nv.x]);
@@ -255,23 +255,23 @@ bool Tableau::checkConsistency() const {
 void Tableau::normalizeRow(LVRef v) {
     assert(isQuasiBasic(v)); // Do not call this for non quasi rows
     Polynomial & row = getRowPoly(v);
-    std::vector<Polynomial::Term const*> toEliminate;
-    for (auto const & term : row) {
+    std::vector<Polynomial::ConstTerm> toEliminate;
+    for (auto const & term : std::as_const(row)) {
         if (isQuasiBasic(term.var)) {
             normalizeRow(term.var);
-            toEliminate.push_back(&term);
+            toEliminate.push_back(term);
         }
         if (isBasic(term.var)) {
-            toEliminate.push_back(&term);
+            toEliminate.push_back(term);
         }
     }
     if (!toEliminate.empty()) {
         Polynomial p;
-        for (auto const* term : toEliminate) {
-            p.merge(getRowPoly(term->var), term->coeff, [](LVRef) {}, [](LVRef) {}, tmp_storage);
-            p.addTerm(term->var, -term->coeff);
+        for (auto const & term : toEliminate) {
+            p.merge(getRowPoly(term.var), term.coeff, [](LVRef) {}, [](LVRef) {});
+            p.addTerm(term.var, -term.coeff);
         }
-        row.merge(p, 1, [](LVRef) {}, [](LVRef) {}, tmp_storage);
+        row.merge(p, 1, [](LVRef) {}, [](LVRef) {});
     }
 }
 
@@ -293,7 +293,7 @@ void Tableau::basicToQuasi(LVRef v) {
     assert(isQuasiBasic(v));
 
     Polynomial & row = getRowPoly(v);
-    for (auto & term : row) {
+    for (auto const & term : row) {
         assert(isNonBasic(term.var));
         removeRowFromColumn(v, term.var);
     }
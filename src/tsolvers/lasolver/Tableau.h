@@ -102,8 +102,6 @@ private:
     };
     std::vector<VarType> varTypes;
 
-    std::vector<Polynomial::Term> tmp_storage;
-
     void ensureTableauReadyFor(LVRef v);
 
     void addRow(LVRef v, std::unique_ptr<Polynomial> p);
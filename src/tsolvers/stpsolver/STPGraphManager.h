@@ -4,21 +4,38 @@
 #include "STPStore.h"
 #include "STPMapper.h"
 #include "STPEdgeGraph.h"
+
+#include <utility>
+#include <vector>
 // implementations of template functions #included below class definitions
 
 
-// stores edges set as true and finds consequences of each added edge
+// stores edges set as true, keeps a feasible potential of the graph and finds consequences of each added edge
 template<class T>
 class STPGraphManager {
 private:
-    // helper struct to return results of DFS
-    struct DFSResult {
-        std::vector<bool> visited;      // map of which vertices were visited
-        std::vector<T> distance;        // map of distances to each visited vertex
-        size_t total{};                 // sum of all edges each vertex appears in
-
-        DFSResult(std::vector<bool> &&vis, std::vector<T> &&dist, size_t total) :
-                visited(std::move(vis)), distance(std::move(dist)), total(total) {}
+    // helper struct holding the state of a Dijkstra search over the reduced costs 'potential[u] + c - potential[v]'
+    // of the edges 'u --c--> v', which are non-negative when the potential is feasible.
+    // The maps are indexed by vertices, and only the vertices in 'touched' are reset after a search.
+    struct Search {
+        std::vector<T> label;               // map of tentative keys of reached vertices
+        std::vector<T> distance;            // map of distances to each settled vertex
+        std::vector<EdgeRef> parent;        // map of last edges of the paths to reached vertices
+        std::vector<char> reached;
+        std::vector<char> settled;
+        std::vector<char> relevant;         // map of vertices whose tentative shortest path goes through the new edge
+        std::vector<VertexRef> touched;     // reached vertices
+        std::vector<VertexRef> order;       // settled relevant vertices, in the order they were settled
+        std::vector<std::pair<T, VertexRef>> queue;  // binary heap of reached vertices, smallest key first
+        size_t relevantInQueue{};           // number of reached relevant vertices that are not settled yet
+        size_t total{};                     // sum of all edges each settled relevant vertex appears in
+
+        static bool laterInQueue(std::pair<T, VertexRef> const & a, std::pair<T, VertexRef> const & b) { return a.first > b.first; }
+
+        void prepare(size_t vertexNum);
+        void reach(VertexRef v, T key, EdgeRef e);
+        VertexRef settleNext();             // VertRef_Undef when the queue is empty
+        void reset();
     };
 
     STPStore<T> &store;
@@ -31,21 +48,34 @@ private:
 
     std::vector<EdgeRef> deductions;
 
-    DFSResult dfsSearch(VertexRef init, bool forward);
+    // For every edge 'u --c--> v' in the graph, potential[v] <= potential[u] + c. Its negation is a model of the graph.
+    // Removing edges keeps the potential feasible, so it survives backtracking.
+    std::vector<T> potential;
+
+    unsigned propagationLimit;  // number of vertices settled in each direction when looking for consequences (0 is no limit)
+
+    Search forwardSearch, backwardSearch;
+
+    void relevantPaths(Search &search, EdgeRef e, bool forward);
 
     void setDeduction(EdgeRef e);
 
 public:
-    explicit STPGraphManager(STPStore<T> &store, STPMapper<T> &mapper) : store(store), mapper(mapper), timestamp(0) {}
+    explicit STPGraphManager(STPStore<T> &store, STPMapper<T> &mapper, unsigned propagationLimit = 0)
+        : store(store), mapper(mapper), timestamp(0), propagationLimit(propagationLimit) {}
 
     const EdgeGraph &getGraph() const { return graph; }
 
+    const std::vector<T> &getPotential() const { return potential; }
+
     bool isTrue(EdgeRef e) const;
 
     uint32_t getAddedCount() const { return timestamp; }
 
     void setTrue(EdgeRef e, PtAsgn asgn);
 
+    std::vector<EdgeRef> updatePotential(EdgeRef e);
+
     std::vector<EdgeRef> findConsequences(EdgeRef e);
 
     void findExplanation(EdgeRef e, vec<PtAsgn> &v);
@@ -1,6 +1,7 @@
 #ifndef OPENSMT_STPGRAPHMANAGER_IMPLEMENTATIONS_HPP
 #define OPENSMT_STPGRAPHMANAGER_IMPLEMENTATIONS_HPP
 
+#include <algorithm>
 #include <stack>
 #include "STPGraphManager.h"
 #include "Converter.h"
@@ -19,6 +20,9 @@ void STPGraphManager<T>::setTrue(EdgeRef e, PtAsgn asgn) {
     edge.setTime = timestamp;
     mapper.setAssignment(e, asgn);
     graph.addEdge(e, edge.from, edge.to);
+    if (potential.size() < store.vertexNum()) {
+        potential.resize(store.vertexNum(), Converter<T>::getValue(0));
+    }
 }
 
 template<class T>
@@ -27,31 +31,130 @@ void STPGraphManager<T>::setDeduction(EdgeRef e) {
     store.getEdge(e).setTime = timestamp;
 }
 
+template<class T>
+void STPGraphManager<T>::Search::prepare(size_t vertexNum) {
+    assert(touched.empty() && queue.empty());
+    if (reached.size() < vertexNum) {
+        label.resize(vertexNum);
+        distance.resize(vertexNum);
+        parent.resize(vertexNum, EdgeRef_Undef);
+        reached.resize(vertexNum, 0);
+        settled.resize(vertexNum, 0);
+        relevant.resize(vertexNum, 0);
+    }
+}
+
+template<class T>
+void STPGraphManager<T>::Search::reach(VertexRef v, T key, EdgeRef e) {
+    if (!reached[v.x]) {
+        reached[v.x] = 1;
+        touched.push_back(v);
+    }
+    label[v.x] = key;
+    parent[v.x] = e;
+    queue.emplace_back(std::move(key), v);
+    std::push_heap(queue.begin(), queue.end(), laterInQueue);
+}
+
+template<class T>
+VertexRef STPGraphManager<T>::Search::settleNext() {
+    while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), laterInQueue);
+        VertexRef v = queue.back().second;
+        queue.pop_back();
+        // a vertex is pushed again whenever its key decreases; the first time it is popped, its key is the smallest
+        if (settled[v.x]) continue;
+        settled[v.x] = 1;
+        if (relevant[v.x]) {
+            --relevantInQueue;
+            order.push_back(v);
+        }
+        return v;
+    }
+    return VertRef_Undef;
+}
+
+template<class T>
+void STPGraphManager<T>::Search::reset() {
+    for (VertexRef v : touched) {
+        reached[v.x] = 0;
+        settled[v.x] = 0;
+        relevant[v.x] = 0;
+        parent[v.x] = EdgeRef_Undef;
+    }
+    touched.clear();
+    order.clear();
+    queue.clear();
+    relevantInQueue = 0;
+    total = 0;
+}
+
+// Restores the feasibility of the potential after adding 'e' to the graph, following Cotton and Maler.
+// Only the vertices whose potential decreases are visited, in the order of the decrease.
+// Returns the edges of a negative cycle through 'e' if there is one, in which case the potential is not changed.
+template<class T>
+std::vector<EdgeRef> STPGraphManager<T>::updatePotential(EdgeRef e) {
+    const Edge<T> &added = store.getEdge(e);
+    T const zero = Converter<T>::getValue(0);
+    T decrease = potential[added.from.x] + added.cost - potential[added.to.x];
+    if (decrease >= zero) return {};
+
+    Search &search = forwardSearch;
+    search.prepare(store.vertexNum());
+    search.reach(added.to, std::move(decrease), e);
+    std::vector<EdgeRef> cycle;
+    for (VertexRef v = search.settleNext(); v != VertRef_Undef; v = search.settleNext()) {
+        if (v == added.from) {
+            // the potential of the source of 'e' would decrease, hence the new path to it closes a negative cycle
+            for (EdgeRef pathEdge = search.parent[v.x]; ; pathEdge = search.parent[store.getEdge(pathEdge).from.x]) {
+                cycle.push_back(pathEdge);
+                if (pathEdge == e) break;
+            }
+            search.reset();
+            return cycle;
+        }
+        T newPotential = potential[v.x] + search.label[v.x];
+        for (EdgeRef eRef : graph.outgoing[v.x]) {
+            const Edge<T> &edge = store.getEdge(eRef);
+            auto next = edge.to;
+            if (search.settled[next.x]) continue;
+            T nextDecrease = newPotential + edge.cost - potential[next.x];
+            if (nextDecrease < zero && (!search.reached[next.x] || nextDecrease < search.label[next.x])) {
+                search.reach(next, std::move(nextDecrease), eRef);
+            }
+        }
+    }
+    for (VertexRef v : search.touched) {
+        assert(search.settled[v.x]);
+        potential[v.x] = potential[v.x] + search.label[v.x];
+    }
+    search.reset();
+    return cycle;
+}
+
 // Searches through the graph to find consequences of currently assigned edges, starting from 'e'
 template<class T>
 std::vector<EdgeRef> STPGraphManager<T>::findConsequences(EdgeRef e) {
-    size_t n = store.vertexNum();
-
     auto &start = store.getEdge(e);
     // find potential starts/ends of an edge with a path going through 'e'
-    auto aRes = dfsSearch(start.from, false);
-    auto bRes = dfsSearch(start.to, true);
+    relevantPaths(backwardSearch, e, false);
+    relevantPaths(forwardSearch, e, true);
 
     // we scan through the side which appears in fewer total edges
-    auto &thisRes = aRes.total < bRes.total ? aRes : bRes;
-    auto &otherRes = aRes.total < bRes.total ? bRes : aRes;
+    bool const scanBackward = backwardSearch.total < forwardSearch.total;
+    auto &thisRes = scanBackward ? backwardSearch : forwardSearch;
+    auto &otherRes = scanBackward ? forwardSearch : backwardSearch;
 
     std::vector<EdgeRef> ret;
-    // for each (WLOG) 'a', go through its edges and find each 'a -> b' edge that has cost higher than length found by DFS
+    // for each (WLOG) 'a', go through its edges and find each 'a -> b' edge that has cost higher than length found by the search
     // such edges are consequences of the current graph
-    for (uint32_t i = 0; i < n; ++i) {
-        if (!thisRes.visited[i]) continue;
-        for (auto eRef : mapper.edgesOf(VertexRef{i})) {
+    for (VertexRef v : thisRes.order) {
+        for (auto eRef : mapper.edgesOf(v)) {
             if (eRef == e) continue;
             const Edge<T> &edge = store.getEdge(eRef);
-            auto thisSide = (aRes.total < bRes.total) ? edge.from.x : edge.to.x;
-            auto otherSide = (aRes.total < bRes.total) ? edge.to.x : edge.from.x;
-            if (thisSide == i && otherRes.visited[otherSide]
+            auto thisSide = scanBackward ? edge.from.x : edge.to.x;
+            auto otherSide = scanBackward ? edge.to.x : edge.from.x;
+            if (thisSide == v.x && otherRes.settled[otherSide] && otherRes.relevant[otherSide]
                 && edge.cost >= thisRes.distance[thisSide] + start.cost + otherRes.distance[otherSide]) {
                 if (edge.setTime == 0) {
                     ret.push_back(eRef);
@@ -60,41 +163,56 @@ std::vector<EdgeRef> STPGraphManager<T>::findConsequences(EdgeRef e) {
             }
         }
     }
+    backwardSearch.reset();
+    forwardSearch.reset();
 
     return ret;
 }
 
-// DFS through the graph to find shortest paths to all reachable vertices from 'init' in the given direction
+// Dijkstra's search for shortest paths from the source of 'e' (forward) or to the target of 'e' (backward), using the
+// reduced costs. Following Cotton and Maler, only the relevant vertices, whose shortest path goes through 'e' and is
+// strictly shorter than any other path, can be ends of consequences of 'e'; the search stops when no relevant vertex is left.
+// The distances of the relevant vertices are stored without 'e', i.e., from the target of 'e' or to the source of 'e'.
+// The search also stops after settling 'propagationLimit' relevant vertices.
 template<class T>
-typename STPGraphManager<T>::DFSResult STPGraphManager<T>::dfsSearch(VertexRef init, bool forward) {
-    std::vector<bool> visited(store.vertexNum());
-    std::vector<T> length(store.vertexNum());
-    size_t total = 0;
-    std::stack<VertexRef> open;
-    visited[init.x] = true;
-    length[init.x] = Converter<T>::getValue(0);
-    open.push(init);
-
-    while (!open.empty()) {
-        VertexRef curr = open.top();
-        open.pop();
+void STPGraphManager<T>::relevantPaths(Search &search, EdgeRef e, bool forward) {
+    const Edge<T> &start = store.getEdge(e);
+    VertexRef init = forward ? start.from : start.to;
+    search.prepare(store.vertexNum());
+    search.reach(init, Converter<T>::getValue(0), EdgeRef_Undef);
+    for (VertexRef curr = search.settleNext(); curr != VertRef_Undef; curr = search.settleNext()) {
+        bool const currRelevant = search.relevant[curr.x];
+        if (currRelevant) {
+            // the reduced length of a path differs from its length by the potentials of its ends
+            T length = forward ? search.label[curr.x] - potential[init.x] + potential[curr.x]
+                               : search.label[curr.x] + potential[init.x] - potential[curr.x];
+            search.distance[curr.x] = length - start.cost;
+            search.total += mapper.edgesOf(curr).size();
+            if (propagationLimit != 0 && search.order.size() >= propagationLimit) break;
+        }
+        else if (curr != init && search.relevantInQueue == 0) {
+            break;
+        }
         auto &toScan = forward ? graph.outgoing[curr.x] : graph.incoming[curr.x];
         for (auto eRef : toScan) {
             const Edge<T> &edge = store.getEdge(eRef);
             auto next = forward ? edge.to : edge.from;
-            if (!visited[next.x]) {
-                visited[next.x] = true;
-                open.push(next);
-                length[next.x] = length[curr.x] + edge.cost;
-                total += mapper.edgesOf(next).size();
-            } else if (length[next.x] > length[curr.x] + edge.cost) {
-                length[next.x] = length[curr.x] + edge.cost;
-                open.push(next);
+            if (search.settled[next.x]) continue;
+            bool const nextRelevant = currRelevant || eRef == e;
+            T key = search.label[curr.x] + potential[edge.from.x] + edge.cost - potential[edge.to.x];
+            if (!search.reached[next.x] || key < search.label[next.x]) {
+                if (search.reached[next.x] && search.relevant[next.x]) { --search.relevantInQueue; }
+                search.relevant[next.x] = nextRelevant;
+                if (nextRelevant) { ++search.relevantInQueue; }
+                search.reach(next, std::move(key), eRef);
+            }
+            else if (search.relevant[next.x] && !nextRelevant && key == search.label[next.x]) {
+                // a path of the same length avoids 'e'
+                search.relevant[next.x] = 0;
+                --search.relevantInQueue;
             }
         }
     }
-
-    return DFSResult(std::move(visited), std::move(length), total);
 }
 
 // removes all edges that have timestamp strictly later than 'point' from the graph
@@ -177,6 +295,7 @@ template<class T>
 void STPGraphManager<T>::clear() {
     timestamp = 0;
     graph.clear();
+    potential.clear();
 }
 
 #endif //OPENSMT_STPGRAPHMANAGER_IMPLEMENTATIONS_HPP
\ No newline at end of file
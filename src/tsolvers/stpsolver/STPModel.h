@@ -10,22 +10,17 @@
 template<class T>
 class STPModel {
 private:
-    STPStore<T> &store;
     EdgeGraph graph;
-    std::unordered_map<uint32_t, T> valMap;  // for each vertex, distance from the added starting vertex
+    std::unordered_map<uint32_t, T> valMap;  // for each vertex, its potential in the graph
 
     std::vector<VertexRef> vertsInGraph() const;
 
-    VertexRef addStartingPoint();
-
-    void bellmanFord(VertexRef start);
-
     void shiftZero();
 
 public:
-    STPModel(STPStore<T> &store, EdgeGraph graph) : store(store), graph(std::move(graph)) {}
+    explicit STPModel(EdgeGraph graph) : graph(std::move(graph)) {}
 
-    void createModel();
+    void createModel(std::vector<T> const & potential);
 
     bool hasValue(VertexRef v) const { return valMap.count(v.x); }
 
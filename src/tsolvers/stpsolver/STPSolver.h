@@ -36,6 +36,7 @@ private:
 
     size_t inv_bpoint;                      // backtrack point where we entered an inconsistent state
     PtAsgn inv_asgn;
+    std::vector<EdgeRef> inv_cycle;         // negative cycle closed by 'inv_asgn', if that is the inconsistency
 
     std::unique_ptr<STPModel<T>> model;           // mapping of vertices (vars) to valid assignments, if it was computed
 
@@ -13,7 +13,7 @@ template<class T>
 STPSolver<T>::STPSolver(SMTConfig &c, ArithLogic &l)
         : TSolver((SolverId) descr_stp_solver, (const char *) descr_stp_solver, c), logic(l),
           mapper(l, store)          // store is initialized before mapper and graph, so these constructors are valid
-        , graphMgr(store, mapper)   // similarly, mapper is initialized before graph (per declaration in header)
+        , graphMgr(store, mapper, c.stp_propagation_limit()) // similarly, mapper is initialized before graph (per declaration in header)
         , inv_bpoint(-1), inv_asgn(PtAsgn_Undef) {}
 
 template<class T>
@@ -123,8 +123,16 @@ bool STPSolver<T>::assertLit(PtAsgn asgn) {
         return false;
     }
 
-    // The assignment isn't decided yet, so we set it as true and find all of its consequences
+    // The assignment isn't decided yet, so we set it as true, check that it does not close a negative cycle,
+    // and find its consequences
     graphMgr.setTrue(set, asgn);
+    inv_cycle = graphMgr.updatePotential(set);
+    if (!inv_cycle.empty()) {
+        inv_bpoint = backtrack_points.size();
+        inv_asgn = asgn;
+        has_explanation = true;
+        return false;
+    }
     std::vector<EdgeRef> deductions = graphMgr.findConsequences(set);
 
     // pass all found deductions to TSolver
@@ -184,6 +192,7 @@ void STPSolver<T>::popBacktrackPoints(unsigned int i) {
     if (inv_bpoint > backtrack_points.size_() - i) {  // if we returned back to a consistent state, we reset inv_bpoint
         inv_bpoint = 0;
         inv_asgn = PtAsgn_Undef;
+        inv_cycle.clear();
         has_explanation = false;
     }
 
@@ -203,13 +212,20 @@ void STPSolver<T>::computeModel() {
         return;
     }
     // In case of satisfiability prepare a model witnessing the satisfiability of the current set of constraints
-    model = std::unique_ptr<STPModel<T>>(new STPModel<T>(store, graphMgr.getGraph()));
-    model->createModel();
+    model = std::unique_ptr<STPModel<T>>(new STPModel<T>(graphMgr.getGraph()));
+    model->createModel(graphMgr.getPotential());
 }
 
 template<class T>
 void STPSolver<T>::getConflict(vec<PtAsgn> & conflict) {
     if (inv_asgn == PtAsgn_Undef) return;
+    if (!inv_cycle.empty()) {
+        for (EdgeRef e : inv_cycle) {
+            assert(mapper.getAssignment(e) != PtAsgn_Undef);
+            conflict.push(mapper.getAssignment(e));
+        }
+        return;
+    }
     conflict.push(inv_asgn);
     EdgeRef e = mapper.getEdgeRef(inv_asgn.tr);
     if (inv_asgn.sgn == l_True) {
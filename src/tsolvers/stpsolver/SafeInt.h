@@ -36,6 +36,8 @@ public:
 
     bool operator>(SafeInt other) const { return val > other.val; }
 
+    bool operator<(SafeInt other) const { return val < other.val; }
+
     bool operator<=(SafeInt other) const { return val <= other.val; }
 
     SafeInt operator-(SafeInt other) const {
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <gtest/gtest.h>
+#include <AIG.h>
+#include <BVLogic.h>
+#include <MainSolver.h>
+#include <SMTConfig.h>
+
+TEST(AIGTest, test_StructuralHashing) {
+    AIG aig;
+    AigLit a = aig.mkInput();
+    AigLit b = aig.mkInput();
+    AigLit ab = aig.mkAnd(a, b);
+    uint32_t size = aig.size();
+    ASSERT_EQ(aig.mkAnd(b, a), ab);
+    ASSERT_EQ(aig.mkOr(~a, ~b), ~ab);
+    ASSERT_EQ(aig.size(), size);
+}
+
+TEST(AIGTest, test_ConstantPropagation) {
+    AIG aig;
+    AigLit a = aig.mkInput();
+    uint32_t size = aig.size();
+    ASSERT_EQ(aig.mkAnd(a, AigLit_True), a);
+    ASSERT_EQ(aig.mkAnd(a, AigLit_False), AigLit_False);
+    ASSERT_EQ(aig.mkAnd(a, ~a), AigLit_False);
+    ASSERT_EQ(aig.mkAnd(a, a), a);
+    ASSERT_EQ(aig.mkXor(a, AigLit_True), ~a);
+    ASSERT_EQ(aig.mkIte(AigLit_False, a, ~a), ~a);
+    ASSERT_EQ(aig.size(), size);
+}
+
+class BitBlastingTest : public ::testing::Test {
+protected:
+    BitBlastingTest() : logic{opensmt::Logic_t::QF_BV, 8}, x(logic.mkBVNumVar("x")), y(logic.mkBVNumVar("y")) {
+        config.setProduceModels();
+    }
+    SMTConfig config;
+    BVLogic logic;
+    PTRef x;
+    PTRef y;
+    PTRef holds(PTRef tr) { return logic.mkEq(tr, logic.getTerm_BVOne()); }
+};
+
+TEST_F(BitBlastingTest, test_Overflow) {
+    MainSolver solver(logic, config, "bv");
+    solver.insertFormula(logic.mkEq(logic.mkBVPlus(x, logic.getTerm_BVOne()), logic.getTerm_BVZero()));
+    ASSERT_EQ(solver.check(), s_True);
+    ASSERT_EQ(solver.getModel()->evaluate(x), logic.mkBVConst(-1));
+}
+
+TEST_F(BitBlastingTest, test_Multiplication) {
+    MainSolver solver(logic, config, "bv");
+    solver.insertFormula(logic.mkEq(logic.mkBVTimes(x, logic.mkBVConst(3)), logic.mkBVConst(5)));
+    ASSERT_EQ(solver.check(), s_True);
+    ASSERT_EQ(solver.getModel()->evaluate(x), logic.mkBVConst(87));
+}
+
+TEST_F(BitBlastingTest, test_Division) {
+    MainSolver solver(logic, config, "bv");
+    solver.insertFormula(logic.mkEq(logic.mkBVDiv(x, logic.mkBVConst(7)), logic.mkBVConst(30)));
+    solver.insertFormula(logic.mkEq(logic.mkBVMod(x, logic.mkBVConst(7)), logic.mkBVConst(4)));
+    ASSERT_EQ(solver.check(), s_True);
+    ASSERT_EQ(solver.getModel()->evaluate(x), logic.mkBVConst(214));
+}
+
+TEST_F(BitBlastingTest, test_DivisionByZero) {
+    MainSolver solver(logic, config, "bv");
+    solver.insertFormula(logic.mkNot(logic.mkEq(logic.mkBVDiv(x, logic.getTerm_BVZero()), logic.mkBVConst(-1))));
+    ASSERT_EQ(solver.check(), s_False);
+}
+
+TEST_F(BitBlastingTest, test_SignedAndUnsignedComparison) {
+    MainSolver solver(logic, config, "bv");
+    solver.insertFormula(holds(logic.mkBVSlt(x, logic.getTerm_BVZero())));
+    ASSERT_EQ(solver.check(), s_True);
+    solver.insertFormula(holds(logic.mkBVUlt(x, logic.mkBVConst(128))));
+    ASSERT_EQ(solver.check(), s_False);
+}
+
+TEST_F(BitBlastingTest, test_Shifts) {
+    MainSolver solver(logic, config, "bv");
+    PTRef minusOne = logic.mkBVConst(-1);
+    solver.insertFormula(logic.mkEq(logic.mkBVLshift(logic.getTerm_BVOne(), x), logic.mkBVConst(16)));
+    solver.insertFormula(logic.mkEq(logic.mkBVARshift(minusOne, x), minusOne));
+    solver.insertFormula(logic.mkEq(logic.mkBVLRshift(minusOne, x), logic.mkBVConst(15)));
+    ASSERT_EQ(solver.check(), s_True);
+    ASSERT_EQ(solver.getModel()->evaluate(x), logic.mkBVConst(4));
+}
+
+TEST_F(BitBlastingTest, test_BitwiseOperations) {
+    MainSolver solver(logic, config, "bv");
+    solver.insertFormula(logic.mkEq(logic.mkBVBwXor(x, y), x));
+    solver.insertFormula(holds(logic.mkBVNot(logic.mkBVEq(logic.mkBVBwAnd(y, logic.mkBVCompl(y)), logic.getTerm_BVZero()))));
+    ASSERT_EQ(solver.check(), s_False);
+}
+
+TEST_F(BitBlastingTest, test_Incremental) {
+    MainSolver solver(logic, config, "bv");
+    solver.insertFormula(holds(logic.mkBVUlt(x, y)));
+    solver.push();
+    solver.insertFormula(holds(logic.mkBVUlt(y, x)));
+    ASSERT_EQ(solver.check(), s_False);
+    solver.pop();
+    solver.insertFormula(holds(logic.mkBVLand(logic.mkBVUgt(y, logic.mkBVConst(254)), logic.mkBVNot(x))));
+    ASSERT_EQ(solver.check(), s_True);
+    auto model = solver.getModel();
+    ASSERT_EQ(model->evaluate(x), logic.getTerm_BVZero());
+    ASSERT_EQ(model->evaluate(y), logic.mkBVConst(-1));
+}
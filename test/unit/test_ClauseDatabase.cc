@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <gtest/gtest.h>
+#include <SolverTypes.h>
+#include <Logic.h>
+#include <MainSolver.h>
+#include <SMTConfig.h>
+
+#include <string>
+#include <vector>
+
+TEST(ClauseTierTest, test_NewLearntClauseIsLocal) {
+    ClauseAllocator ca;
+    vec<Lit> lits{mkLit(0), mkLit(1, true), mkLit(2)};
+    CRef cr = ca.alloc(lits, true);
+    ASSERT_EQ(ca[cr].lbd(), 3);
+    ASSERT_EQ(ca[cr].tier(), Clause::tier_local);
+    ASSERT_FALSE(ca[cr].used());
+}
+
+TEST(ClauseTierTest, test_RelocationKeepsTier) {
+    ClauseAllocator from;
+    vec<Lit> lits{mkLit(0), mkLit(1, true), mkLit(2), mkLit(3)};
+    CRef cr = from.alloc(lits, true);
+    from[cr].lbd(2);
+    from[cr].tier(Clause::tier_core);
+    from[cr].used(true);
+    from[cr].activity() = 5;
+
+    ClauseAllocator to;
+    from.reloc(cr, to);
+    ASSERT_EQ(to[cr].size(), 4);
+    ASSERT_EQ(to[cr].lbd(), 2);
+    ASSERT_EQ(to[cr].tier(), Clause::tier_core);
+    ASSERT_TRUE(to[cr].used());
+    ASSERT_EQ(to[cr].activity(), 5);
+}
+
+class ClauseDatabaseTest : public ::testing::Test {
+protected:
+    ClauseDatabaseTest() : logic{opensmt::Logic_t::QF_UF} {}
+    SMTConfig config;
+    Logic logic;
+
+    // n+1 pigeons do not fit in n holes
+    PTRef pigeonHole(int n) {
+        std::vector<std::vector<PTRef>> p(n + 1);
+        for (int i = 0; i <= n; i++) {
+            for (int j = 0; j < n; j++)
+                p[i].push_back(logic.mkBoolVar(("p_" + std::to_string(i) + "_" + std::to_string(j)).c_str()));
+        }
+        vec<PTRef> constraints;
+        for (int i = 0; i <= n; i++) {
+            vec<PTRef> holes;
+            for (PTRef tr : p[i])
+                holes.push(tr);
+            constraints.push(logic.mkOr(std::move(holes)));
+        }
+        for (int j = 0; j < n; j++)
+            for (int i = 0; i <= n; i++)
+                for (int k = i + 1; k <= n; k++)
+                    constraints.push(logic.mkOr(logic.mkNot(p[i][j]), logic.mkNot(p[k][j])));
+        return logic.mkAnd(std::move(constraints));
+    }
+};
+
+TEST_F(ClauseDatabaseTest, test_InvalidThresholds) {
+    const char* msg;
+    ASSERT_FALSE(config.setOption(SMTConfig::o_sat_lbd_core, SMTOption(-1), msg));
+    ASSERT_FALSE(config.setOption(SMTConfig::o_sat_lbd_tier2, SMTOption(-1), msg));
+    ASSERT_EQ(config.sat_lbd_core(), 2);
+    ASSERT_EQ(config.sat_lbd_tier2(), 6);
+}
+
+TEST_F(ClauseDatabaseTest, test_AllClausesLocal) {
+    const char* msg;
+    ASSERT_TRUE(config.setOption(SMTConfig::o_sat_lbd_core, SMTOption(0), msg));
+    ASSERT_TRUE(config.setOption(SMTConfig::o_sat_lbd_tier2, SMTOption(0), msg));
+    MainSolver solver(logic, config, "local");
+    solver.insertFormula(pigeonHole(6));
+    ASSERT_EQ(solver.check(), s_False);
+}
+
+TEST_F(ClauseDatabaseTest, test_AllClausesCore) {
+    const char* msg;
+    ASSERT_TRUE(config.setOption(SMTConfig::o_sat_lbd_core, SMTOption(1000), msg));
+    MainSolver solver(logic, config, "core");
+    solver.insertFormula(pigeonHole(6));
+    ASSERT_EQ(solver.check(), s_False);
+}
+
+TEST_F(ClauseDatabaseTest, test_Incremental) {
+    MainSolver solver(logic, config, "incremental");
+    PTRef a = logic.mkBoolVar("a");
+    solver.insertFormula(a);
+    solver.push();
+    solver.insertFormula(pigeonHole(6));
+    ASSERT_EQ(solver.check(), s_False);
+    solver.pop();
+    ASSERT_EQ(solver.check(), s_True);
+    solver.insertFormula(pigeonHole(5));
+    ASSERT_EQ(solver.check(), s_False);
+}
+
+TEST_F(ClauseDatabaseTest, test_BinaryImplicationChain) {
+    config.setProduceModels();
+    MainSolver solver(logic, config, "binary");
+    std::vector<PTRef> x;
+    for (int i = 0; i < 20; i++)
+        x.push_back(logic.mkBoolVar(("x_" + std::to_string(i)).c_str()));
+    for (int i = 0; i + 1 < 20; i++)
+        solver.insertFormula(logic.mkOr(logic.mkNot(x[i]), x[i + 1]));
+    // Binary and long clauses imply the same literal
+    solver.insertFormula(logic.mkOr(vec<PTRef>{logic.mkNot(x[0]), logic.mkNot(x[10]), x[19]}));
+    solver.insertFormula(x[0]);
+    ASSERT_EQ(solver.check(), s_True);
+    auto model = solver.getModel();
+    for (PTRef tr : x)
+        ASSERT_EQ(model->evaluate(tr), logic.getTerm_true());
+    solver.push();
+    solver.insertFormula(logic.mkOr(logic.mkNot(x[5]), logic.mkNot(x[15])));
+    ASSERT_EQ(solver.check(), s_False);
+    solver.pop();
+    ASSERT_EQ(solver.check(), s_True);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <gtest/gtest.h>
+#include <ArithLogic.h>
+#include <FastRational.h>
+#include <MainSolver.h>
+#include <SMTConfig.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+// x_0 >= 1 and x_{i+1} >= k*x_i + b with coefficients that do not fit in a word.  If bounded, also x_n <= 0.
+sstat solveChain(int n, int seed, bool bounded) {
+    SMTConfig config;
+    ArithLogic logic{opensmt::Logic_t::QF_LRA};
+    MainSolver solver(logic, config, "concurrent");
+    PTRef k = logic.mkConst(("98765432109876543210" + std::to_string(seed) + "/7").c_str());
+    PTRef b = logic.mkConst(("12345678901234567890" + std::to_string(seed) + "/11").c_str());
+    vec<PTRef> xs;
+    for (int i = 0; i <= n; i++) {
+        xs.push(logic.mkRealVar(("x" + std::to_string(i)).c_str()));
+    }
+    solver.insertFormula(logic.mkGeq(xs[0], logic.getTerm_RealOne()));
+    for (int i = 0; i < n; i++) {
+        solver.insertFormula(logic.mkGeq(xs[i + 1], logic.mkPlus(logic.mkTimes(k, xs[i]), b)));
+        // Give the SAT solver something to decide
+        PTRef c = logic.mkConst(std::to_string(i * seed + 3).c_str());
+        solver.insertFormula(logic.mkOr(logic.mkLeq(xs[i], c), logic.mkGeq(xs[i], logic.mkTimes(c, k))));
+    }
+    if (bounded) {
+        solver.insertFormula(logic.mkLeq(xs[n], logic.getTerm_RealZero()));
+    }
+    return solver.check();
+}
+}
+
+TEST(ConcurrentSolversTest, test_IndependentLRASolvers) {
+    constexpr int threadCount = 8;
+    constexpr int rounds = 10;
+    std::atomic<int> wrongAnswers{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([t, &wrongAnswers]() {
+            for (int r = 0; r < rounds; r++) {
+                bool bounded = (t + r) % 2 == 0;
+                sstat res = solveChain(10 + r, t + 1, bounded);
+                if (res != (bounded ? s_False : s_True)) { wrongAnswers++; }
+            }
+        });
+    }
+    for (auto & thread : threads) { thread.join(); }
+    ASSERT_EQ(wrongAnswers.load(), 0);
+}
+
+TEST(ConcurrentSolversTest, test_RationalOutlivesThread) {
+    std::vector<FastRational> values;
+    std::thread producer([&values]() {
+        FastRational big("123456789012345678901234567890/7");
+        for (int i = 0; i < 100; i++) {
+            values.push_back(big * i);
+        }
+    });
+    producer.join();
+    FastRational sum = 0;
+    for (auto const & v : values) {
+        sum += v;
+    }
+    ASSERT_EQ(sum, FastRational("123456789012345678901234567890/7") * 4950);
+    values.clear();
+    // The values released by the main thread are recycled here
+    FastRational other("98765432109876543210987654321/3");
+    ASSERT_EQ(other * 3, FastRational("98765432109876543210987654321"));
+}
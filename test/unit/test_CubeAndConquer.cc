@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <gtest/gtest.h>
+#include <ArithLogic.h>
+#include <CubeQueue.h>
+#include <Logic.h>
+#include <MainSolver.h>
+#include <SMTConfig.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(CubeQueueTest, test_OwnNewestStealOldest) {
+    CubeQueue queue(2);
+    queue.push(0, vec<Lit>{mkLit(1)});
+    queue.push(0, vec<Lit>{mkLit(2)});
+    queue.push(0, vec<Lit>{mkLit(3)});
+
+    vec<Lit> cube;
+    ASSERT_TRUE(queue.pop(0, cube));
+    ASSERT_EQ(cube[0], mkLit(3));
+    ASSERT_TRUE(queue.pop(1, cube));
+    ASSERT_EQ(cube[0], mkLit(1));
+    ASSERT_TRUE(queue.pop(1, cube));
+    ASSERT_EQ(cube[0], mkLit(2));
+    queue.done();
+    queue.done();
+    queue.done();
+    ASSERT_FALSE(queue.pop(0, cube));
+}
+
+TEST(CubeQueueTest, test_Cancel) {
+    CubeQueue queue(1);
+    queue.push(0, vec<Lit>{mkLit(1)});
+    queue.cancel();
+    vec<Lit> cube;
+    ASSERT_FALSE(queue.pop(0, cube));
+    ASSERT_TRUE(queue.isCancelled());
+}
+
+TEST(CubeQueueTest, test_SplittingWorkers) {
+    // Every cube shorter than the depth is split in two; all leaves must be processed exactly once
+    constexpr int workers = 4;
+    constexpr int depth = 8;
+    CubeQueue queue(workers);
+    queue.push(0, vec<Lit>{});
+    std::atomic<int> leaves{0};
+    std::vector<std::thread> threads;
+    for (int id = 0; id < workers; id++) {
+        threads.emplace_back([&queue, &leaves, id]() {
+            vec<Lit> cube;
+            while (queue.pop(id, cube)) {
+                if (cube.size() < depth) {
+                    vec<Lit> other;
+                    cube.copyTo(other);
+                    other.push(mkLit(cube.size(), true));
+                    cube.push(mkLit(cube.size()));
+                    queue.push(id, std::move(other));
+                    queue.push(id, std::move(cube));
+                } else {
+                    leaves++;
+                }
+                queue.done();
+            }
+        });
+    }
+    for (auto & thread : threads) { thread.join(); }
+    ASSERT_EQ(leaves.load(), 1 << depth);
+}
+
+class CubeAndConquerTest : public ::testing::Test {
+protected:
+    CubeAndConquerTest() {
+        const char* msg;
+        config.setOption(SMTConfig::o_sat_lookahead_split, SMTOption(1), msg);
+        config.setOption(SMTConfig::o_sat_split_num, SMTOption(8), msg);
+        config.setOption(SMTConfig::o_sat_split_conquer, SMTOption(1), msg);
+        config.setOption(SMTConfig::o_threads, SMTOption(4), msg);
+    }
+    SMTConfig config;
+
+    // n+1 pigeons do not fit in n holes
+    static PTRef pigeonHole(Logic & logic, int n) {
+        std::vector<std::vector<PTRef>> p(n + 1);
+        for (int i = 0; i <= n; i++) {
+            for (int j = 0; j < n; j++)
+                p[i].push_back(logic.mkBoolVar(("p_" + std::to_string(i) + "_" + std::to_string(j)).c_str()));
+        }
+        vec<PTRef> constraints;
+        for (int i = 0; i <= n; i++) {
+            vec<PTRef> holes;
+            for (PTRef tr : p[i])
+                holes.push(tr);
+            constraints.push(logic.mkOr(std::move(holes)));
+        }
+        for (int j = 0; j < n; j++)
+            for (int i = 0; i <= n; i++)
+                for (int k = i + 1; k <= n; k++)
+                    constraints.push(logic.mkOr(logic.mkNot(p[i][j]), logic.mkNot(p[k][j])));
+        return logic.mkAnd(std::move(constraints));
+    }
+};
+
+TEST_F(CubeAndConquerTest, test_Unsat) {
+    Logic logic{opensmt::Logic_t::QF_UF};
+    MainSolver solver(logic, config, "cube-and-conquer");
+    solver.insertFormula(pigeonHole(logic, 7));
+    ASSERT_EQ(solver.check(), s_False);
+}
+
+TEST_F(CubeAndConquerTest, test_SatWithModel) {
+    config.setProduceModels();
+    Logic logic{opensmt::Logic_t::QF_UF};
+    SRef U = logic.declareUninterpretedSort("U");
+    PTRef x = logic.mkVar(U, "x");
+    PTRef y = logic.mkVar(U, "y");
+    SymRef f_sym = logic.declareFun("f", U, {U});
+    PTRef fx = logic.mkUninterpFun(f_sym, {x});
+    PTRef fy = logic.mkUninterpFun(f_sym, {y});
+    vec<PTRef> bs;
+    for (int i = 0; i < 6; i++)
+        bs.push(logic.mkBoolVar(("b" + std::to_string(i)).c_str()));
+
+    MainSolver solver(logic, config, "cube-and-conquer");
+    solver.insertFormula(logic.mkOr(bs[0], logic.mkEq(x, y)));
+    solver.insertFormula(logic.mkOr(logic.mkNot(bs[0]), logic.mkNot(logic.mkEq(fx, fy))));
+    for (int i = 1; i < bs.size(); i++)
+        solver.insertFormula(logic.mkOr(bs[i - 1], bs[i]));
+    ASSERT_EQ(solver.check(), s_True);
+    auto model = solver.getModel();
+    bool b0 = model->evaluate(bs[0]) == logic.getTerm_true();
+    ASSERT_TRUE(b0 or model->evaluate(x) == model->evaluate(y));
+    ASSERT_TRUE(not b0 or model->evaluate(fx) != model->evaluate(fy));
+    for (int i = 1; i < bs.size(); i++)
+        ASSERT_TRUE(model->evaluate(bs[i - 1]) == logic.getTerm_true() or model->evaluate(bs[i]) == logic.getTerm_true());
+}
+
+TEST_F(CubeAndConquerTest, test_ArithmeticInOneThread) {
+    ArithLogic logic{opensmt::Logic_t::QF_LRA};
+    PTRef x = logic.mkRealVar("x");
+    PTRef y = logic.mkRealVar("y");
+    PTRef a = logic.mkBoolVar("a");
+    PTRef b = logic.mkBoolVar("b");
+    MainSolver solver(logic, config, "cube-and-conquer");
+    solver.insertFormula(logic.mkOr(a, logic.mkLeq(x, logic.getTerm_RealZero())));
+    solver.insertFormula(logic.mkOr(b, logic.mkGeq(y, logic.getTerm_RealOne())));
+    solver.insertFormula(logic.mkOr(logic.mkNot(a), logic.mkGeq(x, logic.mkConst("2"))));
+    solver.insertFormula(logic.mkOr(logic.mkNot(b), logic.mkLeq(y, logic.mkConst("-2"))));
+    solver.insertFormula(logic.mkEq(x, y));
+    ASSERT_EQ(solver.check(), s_True);
+    solver.insertFormula(logic.mkLeq(logic.mkPlus(x, y), logic.mkConst("3")));
+    solver.insertFormula(logic.mkGeq(logic.mkPlus(x, y), logic.getTerm_RealOne()));
+    ASSERT_EQ(solver.check(), s_False);
+}
@@ -61,9 +61,9 @@ TEST(UseVector_test, testWriteRead){
 
 class EgraphTest: public ::testing::Test {
 public:
+    SMTConfig c;
     Logic logic;
     Egraph egraph;
-    SMTConfig c;
     EgraphTest() : logic{opensmt::Logic_t::QF_UF}, egraph(c, logic) {}
 };
 
@@ -139,3 +139,137 @@ TEST_F(EgraphTest, test_IncrementalAddition) {
     ASSERT_TRUE(egraph.assertLit({eq3, l_True}));
     ASSERT_EQ(egraph.check(true), TRes::SAT);
 }
+
+TEST_F(EgraphTest, test_ManyDistinctions) {
+    SRef sref = logic.declareUninterpretedSort("U");
+    vec<PTRef> vars;
+    for (int i = 0; i < 42; i++) {
+        vars.push(logic.mkVar(sref, ("a" + std::to_string(i)).c_str()));
+    }
+    vec<PTRef> distincts;
+    for (int i = 0; i < 40; i++) {
+        distincts.push(logic.mkDistinct({vars[i], vars[i+1], vars[i+2]}));
+        ASSERT_TRUE(logic.isDisequality(distincts.last()));
+        egraph.declareAtom(distincts.last());
+    }
+    PTRef eq1 = logic.mkEq(vars[39], vars[41]);
+    PTRef eq2 = logic.mkEq(vars[0], vars[38]);
+    PTRef eq3 = logic.mkEq(vars[0], vars[40]);
+    for (PTRef eq : {eq1, eq2, eq3}) {
+        egraph.declareAtom(eq);
+    }
+    egraph.pushBacktrackPoint();
+    for (PTRef distinct : distincts) {
+        ASSERT_TRUE(egraph.assertLit({distinct, l_True}));
+    }
+    ASSERT_EQ(egraph.check(true), TRes::SAT);
+
+    egraph.pushBacktrackPoint();
+    ASSERT_FALSE(egraph.assertLit({eq1, l_True}));
+    vec<PtAsgn> expl;
+    egraph.getConflict(expl);
+    ASSERT_EQ(expl.size(), 2);
+    egraph.popBacktrackPoint();
+
+    // The classes of a0 and a38 do not share a distinction, but after the merge a0 and a40 are both in the last ones
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({eq2, l_True}));
+    ASSERT_EQ(egraph.check(true), TRes::SAT);
+    egraph.pushBacktrackPoint();
+    ASSERT_FALSE(egraph.assertLit({eq3, l_True}));
+    expl.clear();
+    egraph.getConflict(expl);
+    ASSERT_EQ(expl.size(), 3);
+    egraph.popBacktrackPoint();
+    egraph.popBacktrackPoint();
+
+    // Undoing the merge leaves a0 and a40 in different distinctions
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({eq3, l_True}));
+    ASSERT_EQ(egraph.check(true), TRes::SAT);
+}
+
+TEST_F(EgraphTest, test_EqualityPropagation) {
+    SRef sref = logic.declareUninterpretedSort("U");
+    PTRef x = logic.mkVar(sref, "x");
+    PTRef y = logic.mkVar(sref, "y");
+    PTRef z = logic.mkVar(sref, "z");
+    PTRef w = logic.mkVar(sref, "w");
+    PTRef eq_xy = logic.mkEq(x, y);
+    PTRef eq_yz = logic.mkEq(y, z);
+    PTRef eq_xz = logic.mkEq(x, z);
+    PTRef eq_zw = logic.mkEq(z, w);
+    PTRef eq_xw = logic.mkEq(x, w);
+    for (PTRef eq : {eq_xy, eq_yz, eq_xz, eq_zw, eq_xw}) {
+        egraph.declareAtom(eq);
+    }
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({eq_xy, l_True}));
+    ASSERT_EQ(egraph.getDeduction().tr, PTRef_Undef);
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({eq_zw, l_False}));
+    ASSERT_EQ(egraph.getDeduction().tr, PTRef_Undef);
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({eq_yz, l_True}));
+
+    vec<PtAsgn_reason> deductions;
+    for (PtAsgn_reason ded = egraph.getDeduction(); ded.tr != PTRef_Undef; ded = egraph.getDeduction()) {
+        deductions.push(ded);
+    }
+    ASSERT_EQ(deductions.size(), 2);
+    for (PtAsgn_reason ded : deductions) {
+        ASSERT_TRUE((ded.tr == eq_xz and ded.sgn == l_True) or (ded.tr == eq_xw and ded.sgn == l_False));
+    }
+    vec<PtAsgn> reason = egraph.getReasonFor(PtAsgn(eq_xw, l_False));
+    ASSERT_EQ(reason.size(), 4);
+
+    egraph.popBacktrackPoint();
+    ASSERT_EQ(egraph.getDeduction().tr, PTRef_Undef);
+    // The deductions were undone with the merge, and asserting a disequality propagates to the class of x
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({eq_xz, l_False}));
+    PtAsgn_reason ded = egraph.getDeduction();
+    ASSERT_EQ(ded.tr, eq_yz);
+    ASSERT_EQ(ded.sgn, l_False);
+    ASSERT_EQ(egraph.getDeduction().tr, PTRef_Undef);
+}
+
+TEST_F(EgraphTest, test_ReasonsAfterBacktracking) {
+    SRef sref = logic.declareUninterpretedSort("U");
+    PTRef x = logic.mkVar(sref, "x");
+    PTRef y = logic.mkVar(sref, "y");
+    PTRef z = logic.mkVar(sref, "z");
+    PTRef w = logic.mkVar(sref, "w");
+    PTRef eq_xy = logic.mkEq(x, y);
+    PTRef eq_yz = logic.mkEq(y, z);
+    PTRef eq_xz = logic.mkEq(x, z);
+    PTRef eq_xw = logic.mkEq(x, w);
+    PTRef eq_wz = logic.mkEq(w, z);
+    for (PTRef eq : {eq_xy, eq_yz, eq_xz, eq_xw, eq_wz}) {
+        egraph.declareAtom(eq);
+    }
+    auto contains = [](vec<PtAsgn> const & reason, PTRef tr) {
+        return std::find_if(reason.begin(), reason.end(), [tr](PtAsgn pta) { return pta.tr == tr; }) != reason.end();
+    };
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({eq_xy, l_True}));
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({eq_yz, l_True}));
+    ASSERT_EQ(egraph.getDeduction().tr, eq_xz);
+    vec<PtAsgn> reason = egraph.getReasonFor({eq_xz, l_True});
+    ASSERT_TRUE(contains(reason, eq_yz));
+    // A backtrack that keeps the literals of the reason keeps the reason
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({eq_xw, l_False}));
+    egraph.popBacktrackPoint();
+    ASSERT_TRUE(contains(egraph.getReasonFor({eq_xz, l_True}), eq_yz));
+    // A backtrack removing a literal of the reason forgets it
+    egraph.popBacktrackPoint();
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({eq_xw, l_True}));
+    ASSERT_TRUE(egraph.assertLit({eq_wz, l_True}));
+    ASSERT_EQ(egraph.getDeduction().tr, eq_xz);
+    reason = egraph.getReasonFor({eq_xz, l_True});
+    ASSERT_FALSE(contains(reason, eq_yz));
+    ASSERT_TRUE(contains(reason, eq_wz));
+}
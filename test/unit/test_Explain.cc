@@ -47,7 +47,7 @@ TEST_F(UFExplainTest, test_UFExplain) {
     PTRef eq3 = logic.mkEq(f_f_c2_c0_c0.tr, c0.tr);
     PTRef eq7 = logic.mkEq(f_c1_c0.tr, c1.tr);
 
-    Explainer explainer(store);
+    Explainer explainer(store, logic);
     explainer.storeExplanation(c2.er, c1.er, {eq1, l_True});
     explainer.storeExplanation(f_f_c2_c0_c0.er, c0.er, {eq3, l_True});
     explainer.storeExplanation(c1.er, f_c1_c0.er, {eq7, l_True});
@@ -70,4 +70,24 @@ TEST_F(UFExplainTest, test_UFExplain) {
         }
     }
 
-}
\ No newline at end of file
+}
+TEST_F(UFExplainTest, test_ExplanationMinimization) {
+    PTRef eq1 = logic.mkEq(c1.tr, c2.tr);
+    PTRef eq2 = logic.mkEq(c2.tr, f_c1_c0.tr);
+    PTRef eq3 = logic.mkEq(f_c1_c0.tr, f_c2_c0.tr);
+
+    for (int limit : {0, 10}) {
+        Explainer explainer(store, logic);
+        explainer.setMinimizationLimit(limit);
+        explainer.storeExplanation(c1.er, c2.er, {eq1, l_True});
+        explainer.storeExplanation(c2.er, f_c1_c0.er, {eq2, l_True});
+        explainer.storeExplanation(f_c1_c0.er, f_c2_c0.er, {eq3, l_True});
+        vec<PtAsgn> explanation = explainer.explain(c1.er, f_c2_c0.er);
+        // f(c1, c0) = f(c2, c0) follows from c1 = c2 by congruence
+        ASSERT_EQ(explanation.size(), limit == 0 ? 3 : 2);
+        ASSERT_EQ(explainer.getStats().minimizedLiterals, limit == 0 ? 0 : 1);
+        for (PtAsgn pta : explanation) {
+            ASSERT_TRUE(limit == 0 or pta.tr != eq3);
+        }
+    }
+}
@@ -319,3 +319,45 @@ TEST_F(HNF_test, test_hnf9) {
 }
 
 
+
+TEST_F(HNF_test, test_hnfTransformationOfWideMatrix) {
+    int rows = 2;
+    int cols = 4;
+    MId A = ms.getNewMatrix(rows, cols);
+
+    int a[2][4] = {{1, 1, -2, 0},
+                   {1, -1, 0, -2}};
+
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+            ms.MM(A, i+1, j+1) = a[i][j];
+
+    MId H = ms.getNewMatrix(rows, cols);
+    MId R = ms.getNewMatrix(cols, cols);
+    MId Ri = ms.getNewMatrix(cols, cols);
+    int dim;
+    ms.compute_hnf_v1(A, H, dim, R, Ri);
+    ASSERT_EQ(dim, 2);
+
+    // A = H*R, R*Ri = I
+    for (int i = 1; i <= rows; i++) {
+        for (int j = 1; j <= cols; j++) {
+            opensmt::Real sum = 0;
+            for (int k = 1; k <= cols; k++)
+                sum += ms.MM(H, i, k) * ms.MM(R, k, j);
+            ASSERT_EQ(sum, ms.MM(A, i, j));
+        }
+    }
+    for (int i = 1; i <= cols; i++) {
+        for (int j = 1; j <= cols; j++) {
+            opensmt::Real sum = 0;
+            for (int k = 1; k <= cols; k++)
+                sum += ms.MM(R, i, k) * ms.MM(Ri, k, j);
+            ASSERT_EQ(sum, i == j ? 1 : 0);
+        }
+    }
+    // H is lower triangular
+    for (int i = 1; i <= rows; i++)
+        for (int j = i + 1; j <= cols; j++)
+            ASSERT_EQ(ms.MM(H, i, j), 0);
+}
@@ -7,6 +7,8 @@
 #include <ArithLogic.h>
 #include <IDLSolver.h>
 
+#include <algorithm>
+
 class IDLSolverTest : public ::testing::Test {
 protected:
     IDLSolverTest() : logic{opensmt::Logic_t::QF_IDL} {}
@@ -110,6 +112,50 @@ TEST_F(IDLSolverTest, test_SimpleTest){
     ASSERT_GT(numY, -2);
 }
 
+TEST_F(IDLSolverTest, test_NegativeCycleWithoutPropagation){
+    // With propagation limited to the ends of the asserted edge, the inconsistency shows up as a negative cycle
+    const char* msg;
+    ASSERT_TRUE(config.setOption(SMTConfig::o_stp_propagation_limit, SMTOption(1), msg));
+    PTRef ineq1 = logic.mkLeq(logic.mkMinus(x, y), logic.getTerm_IntZero());
+    PTRef ineq2 = logic.mkLeq(logic.mkMinus(y, z), logic.getTerm_IntZero());
+    PTRef ineq3 = logic.mkLeq(logic.mkMinus(z, x), logic.mkIntConst(-1));
+
+    IDLSolver solver(config, logic);
+    for (PTRef ineq : {ineq1, ineq2, ineq3}) {
+        solver.declareAtom(ineq);
+    }
+    for (PTRef ineq : {ineq1, ineq2}) {
+        solver.pushBacktrackPoint();
+        ASSERT_TRUE(solver.assertLit(PtAsgn(ineq, l_True)));
+    }
+    solver.pushBacktrackPoint();
+    ASSERT_FALSE(solver.assertLit(PtAsgn(ineq3, l_True)));
+    ASSERT_EQ(solver.check(true), TRes::UNSAT);
+    vec<PtAsgn> conflict;
+    solver.getConflict(conflict);
+    ASSERT_EQ(conflict.size(), 3);
+    for (PTRef ineq : {ineq1, ineq2, ineq3}) {
+        ASSERT_TRUE(std::find(conflict.begin(), conflict.end(), PtAsgn(ineq, l_True)) != conflict.end());
+    }
+
+    solver.popBacktrackPoints(1);
+    ASSERT_EQ(solver.check(true), TRes::SAT);
+    solver.pushBacktrackPoint();
+    ASSERT_TRUE(solver.assertLit(PtAsgn(ineq3, l_False)));
+    ASSERT_EQ(solver.check(true), TRes::SAT);
+
+    // the model is the potential maintained across the conflict and the backtracking
+    solver.computeModel();
+    ModelBuilder builder(logic);
+    solver.fillTheoryFunctions(builder);
+    auto model = builder.build();
+    auto value = [&](PTRef var) { return logic.getNumConst(model->evaluate(var)); };
+    ASSERT_LE(value(x) - value(y), 0);
+    ASSERT_LE(value(y) - value(z), 0);
+    ASSERT_GT(value(z) - value(x), -1);
+    ASSERT_FALSE(config.setOption(SMTConfig::o_stp_propagation_limit, SMTOption(-1), msg));
+}
+
 class SafeIntTest : public ::testing::Test {};
 
 TEST_F(SafeIntTest, test_add_pass){
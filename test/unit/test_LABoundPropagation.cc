@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <gtest/gtest.h>
+#include <lasolver/LASolver.h>
+
+#include <algorithm>
+#include <vector>
+
+class LABoundPropagationTest : public ::testing::Test {
+public:
+    LABoundPropagationTest() : logic(opensmt::Logic_t::QF_LRA), solver(c, logic) {
+        x = logic.mkRealVar("x");
+        y = logic.mkRealVar("y");
+        z = logic.mkRealVar("z");
+    }
+    SMTConfig c;
+    ArithLogic logic;
+    LASolver solver;
+    PTRef x;
+    PTRef y;
+    PTRef z;
+
+    void assertLit(PTRef atom, lbool sgn) {
+        solver.pushBacktrackPoint();
+        ASSERT_TRUE(solver.assertLit({atom, sgn}));
+    }
+
+    std::vector<PtAsgn> getDeductions() {
+        std::vector<PtAsgn> deductions;
+        for (PtAsgn_reason ded = solver.getDeduction(); ded.tr != PTRef_Undef; ded = solver.getDeduction()) {
+            deductions.push_back(PtAsgn(ded.tr, ded.sgn));
+        }
+        return deductions;
+    }
+
+    static bool contains(std::vector<PtAsgn> const & asgns, PtAsgn asgn) {
+        return std::find(asgns.begin(), asgns.end(), asgn) != asgns.end();
+    }
+};
+
+TEST_F(LABoundPropagationTest, test_DeduceSumFromBoundsOfVariables) {
+    PTRef xGeq1 = logic.mkGeq(x, logic.getTerm_RealOne());
+    PTRef yGeq1 = logic.mkGeq(y, logic.getTerm_RealOne());
+    PTRef sumGeq2 = logic.mkGeq(logic.mkPlus(x, y), logic.mkConst("2"));
+    PTRef sumGeq3 = logic.mkGeq(logic.mkPlus(x, y), logic.mkConst("3"));
+    for (PTRef atom : {xGeq1, yGeq1, sumGeq2, sumGeq3}) {
+        solver.declareAtom(atom);
+    }
+    assertLit(xGeq1, l_True);
+    assertLit(yGeq1, l_True);
+    auto deductions = getDeductions();
+    ASSERT_TRUE(contains(deductions, PtAsgn(sumGeq2, l_True)));
+    ASSERT_FALSE(contains(deductions, PtAsgn(sumGeq3, l_True)));
+
+    vec<PtAsgn> reason = solver.getReasonFor(PtAsgn(sumGeq2, l_True));
+    ASSERT_EQ(reason.size(), 3);
+    std::vector<PtAsgn> reasonLits(reason.begin(), reason.end());
+    ASSERT_TRUE(contains(reasonLits, PtAsgn(xGeq1, l_True)));
+    ASSERT_TRUE(contains(reasonLits, PtAsgn(yGeq1, l_True)));
+    ASSERT_TRUE(contains(reasonLits, PtAsgn(sumGeq2, l_False)));
+}
+
+TEST_F(LABoundPropagationTest, test_DeduceVariableFromBoundOfSum) {
+    // x + y + z <= 5, y >= 3, z >= 0 imply x <= 2, and hence not x >= 3, but not x <= 1
+    PTRef sumLeq5 = logic.mkLeq(logic.mkPlus(vec<PTRef>{x, y, z}), logic.mkConst("5"));
+    PTRef yGeq3 = logic.mkGeq(y, logic.mkConst("3"));
+    PTRef zGeq0 = logic.mkGeq(z, logic.getTerm_RealZero());
+    PTRef xLeq2 = logic.mkLeq(x, logic.mkConst("2"));
+    PTRef xGeq3 = logic.mkGeq(x, logic.mkConst("3"));
+    PTRef xLeq1 = logic.mkLeq(x, logic.getTerm_RealOne());
+    for (PTRef atom : {sumLeq5, yGeq3, zGeq0, xLeq2, xGeq3, xLeq1}) {
+        solver.declareAtom(atom);
+    }
+    assertLit(sumLeq5, l_True);
+    assertLit(yGeq3, l_True);
+    ASSERT_TRUE(getDeductions().empty());
+    assertLit(zGeq0, l_True);
+    auto deductions = getDeductions();
+    ASSERT_TRUE(contains(deductions, PtAsgn(xLeq2, l_True)));
+    ASSERT_TRUE(contains(deductions, PtAsgn(xGeq3, l_False)));
+    ASSERT_FALSE(contains(deductions, PtAsgn(xLeq1, l_True)));
+    ASSERT_EQ(solver.getReasonFor(PtAsgn(xLeq2, l_True)).size(), 4);
+}
+
+TEST_F(LABoundPropagationTest, test_BacktrackingUndoesDeductions) {
+    PTRef xGeq1 = logic.mkGeq(x, logic.getTerm_RealOne());
+    PTRef yGeq1 = logic.mkGeq(y, logic.getTerm_RealOne());
+    PTRef sumGeq2 = logic.mkGeq(logic.mkPlus(x, y), logic.mkConst("2"));
+    for (PTRef atom : {xGeq1, yGeq1, sumGeq2}) {
+        solver.declareAtom(atom);
+    }
+    assertLit(xGeq1, l_True);
+    assertLit(yGeq1, l_True);
+    ASSERT_TRUE(contains(getDeductions(), PtAsgn(sumGeq2, l_True)));
+    solver.popBacktrackPoints(2);
+    // The atom can be asserted negatively now, and the solver deduces it again once the bounds are back
+    assertLit(sumGeq2, l_False);
+    solver.popBacktrackPoints(1);
+    assertLit(yGeq1, l_True);
+    assertLit(xGeq1, l_True);
+    ASSERT_TRUE(contains(getDeductions(), PtAsgn(sumGeq2, l_True)));
+}
+
+TEST_F(LABoundPropagationTest, test_RowPropagationCanBeDisabled) {
+    const char* msg;
+    ASSERT_TRUE(c.setOption(SMTConfig::o_lra_propagation_row_size, SMTOption(0), msg));
+    LASolver noPropagation(c, logic);
+    PTRef xGeq1 = logic.mkGeq(x, logic.getTerm_RealOne());
+    PTRef yGeq1 = logic.mkGeq(y, logic.getTerm_RealOne());
+    PTRef sumGeq2 = logic.mkGeq(logic.mkPlus(x, y), logic.mkConst("2"));
+    for (PTRef atom : {xGeq1, yGeq1, sumGeq2}) {
+        noPropagation.declareAtom(atom);
+    }
+    for (PTRef atom : {xGeq1, yGeq1}) {
+        noPropagation.pushBacktrackPoint();
+        ASSERT_TRUE(noPropagation.assertLit({atom, l_True}));
+    }
+    ASSERT_EQ(noPropagation.getDeduction().tr, PTRef_Undef);
+    ASSERT_FALSE(c.setOption(SMTConfig::o_lra_propagation_row_size, SMTOption(-1), msg));
+}
@@ -6,6 +6,7 @@
 #include <SMTConfig.h>
 #include <lasolver/Simplex.h>
 #include <lasolver/LASolver.h>
+#include <MainSolver.h>
 
 
 TEST(LIACutSolver_test, test_computeEqualityBasis)
@@ -122,3 +123,54 @@ cout << sum.D() << endl;
 //4. ckeck simplex on Ax<b if Ax<b is UNSAT then AX<=b implies equality
 */
 
+
+class LIACutTest : public ::testing::Test {
+protected:
+    LIACutTest() : logic{opensmt::Logic_t::QF_LIA} {}
+    ArithLogic logic;
+    SMTConfig config;
+};
+
+TEST_F(LIACutTest, test_ParityNeedsCutFromProof) {
+    // x + y is odd and x - y is even.  The variables are unbounded, so branch-and-bound alone does not terminate
+    PTRef x = logic.mkIntVar("x");
+    PTRef y = logic.mkIntVar("y");
+    PTRef z = logic.mkIntVar("z");
+    PTRef w = logic.mkIntVar("w");
+    PTRef two = logic.mkIntConst(2);
+    MainSolver solver(logic, config, "lia-cuts");
+    solver.insertFormula(logic.mkEq(logic.mkPlus(x, y), logic.mkPlus(logic.mkTimes(two, z), logic.getTerm_IntOne())));
+    solver.insertFormula(logic.mkEq(logic.mkMinus(x, y), logic.mkTimes(two, w)));
+    ASSERT_EQ(solver.check(), s_False);
+}
+
+TEST_F(LIACutTest, test_CutsPreserveSolutions) {
+    // 3x + 5y + 7z = 100 has solutions with 0 <= x, y, z <= 10, but not with x + y + z <= 15, although the relaxation has
+    config.setProduceModels();
+    PTRef x = logic.mkIntVar("x");
+    PTRef y = logic.mkIntVar("y");
+    PTRef z = logic.mkIntVar("z");
+    MainSolver solver(logic, config, "lia-cuts");
+    vec<PTRef> sum {logic.mkTimes(logic.mkIntConst(3), x), logic.mkTimes(logic.mkIntConst(5), y), logic.mkTimes(logic.mkIntConst(7), z)};
+    solver.insertFormula(logic.mkEq(logic.mkPlus(sum), logic.mkIntConst(100)));
+    for (PTRef v : {x, y, z}) {
+        solver.insertFormula(logic.mkGeq(v, logic.getTerm_IntZero()));
+        solver.insertFormula(logic.mkLeq(v, logic.mkIntConst(10)));
+    }
+    ASSERT_EQ(solver.check(), s_True);
+    auto model = solver.getModel();
+    auto value = [&](PTRef v) { return logic.getNumConst(model->evaluate(v)); };
+    ASSERT_EQ(value(x) * 3 + value(y) * 5 + value(z) * 7, 100);
+    solver.push();
+    solver.insertFormula(logic.mkLeq(logic.mkPlus(vec<PTRef>{x, y, z}), logic.mkIntConst(15)));
+    ASSERT_EQ(solver.check(), s_False);
+    solver.pop();
+    ASSERT_EQ(solver.check(), s_True);
+}
+
+TEST_F(LIACutTest, test_CutBudgetOption) {
+    const char* msg;
+    ASSERT_FALSE(config.setOption(SMTConfig::o_lia_cut_budget, SMTOption(-1), msg));
+    ASSERT_TRUE(config.setOption(SMTConfig::o_lia_cut_budget, SMTOption(0), msg));
+    ASSERT_EQ(config.lia_cut_budget(), 0);
+}
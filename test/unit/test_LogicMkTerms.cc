@@ -83,6 +83,7 @@ TEST_F(LogicMkTermsTest, test_ManyDistinct) {
     for (int i = 0; i < distincts1.size(); i++) {
         ASSERT_EQ(distincts1[i].x, distincts2[i].x);
         ASSERT_EQ(distincts1[i].x, distincts3[i].x);
+        ASSERT_TRUE(logic.isDisequality(distincts1[i]));
     }
 }
 
@@ -172,6 +173,75 @@ TEST_F(LogicMkTermsTest, testAtom_UF) {
     EXPECT_FALSE(logic.isAtom(logic.mkNot(pa)));
 }
 
+TEST_F(LogicMkTermsTest, testHashConsing) {
+    SRef sref = logic.declareUninterpretedSort("U");
+    SymRef f = logic.declareFun("f", sref, {sref, sref});
+    SymRef g = logic.declareFun("g", sref, {sref, sref});
+    vec<PTRef> vars;
+    for (int i = 0; i < 100; i++) {
+        vars.push(logic.mkVar(sref, ("x" + std::to_string(i)).c_str()));
+    }
+    vec<PTRef> fterms;
+    for (int i = 0; i < vars.size(); i++) {
+        for (int j = 0; j < vars.size(); j++) {
+            fterms.push(logic.mkUninterpFun(f, {vars[i], vars[j]}));
+        }
+    }
+    auto numTerms = logic.getNumberOfTerms();
+    // Rebuilding the same terms must not create new ones, and each term is distinct from its argument swap
+    for (int i = 0; i < vars.size(); i++) {
+        for (int j = 0; j < vars.size(); j++) {
+            PTRef fij = logic.mkUninterpFun(f, {vars[i], vars[j]});
+            ASSERT_EQ(fij, fterms[i * vars.size() + j]);
+            if (i != j) {
+                ASSERT_NE(fij, logic.mkUninterpFun(f, {vars[j], vars[i]}));
+            }
+        }
+    }
+    ASSERT_EQ(numTerms, logic.getNumberOfTerms());
+    PTRef gterm = logic.mkUninterpFun(g, {vars[0], vars[1]});
+    ASSERT_NE(gterm, fterms[1]);
+    ASSERT_EQ(numTerms + 1, logic.getNumberOfTerms());
+    // Commutative symbols are hash-consed modulo argument order
+    PTRef eq1 = logic.mkEq(fterms[1], gterm);
+    PTRef eq2 = logic.mkEq(gterm, fterms[1]);
+    ASSERT_EQ(eq1, eq2);
+}
+
+TEST_F(LogicMkTermsTest, testGarbageCollection) {
+    SRef sref = logic.declareUninterpretedSort("U");
+    SymRef f = logic.declareFun("f", sref, {sref, sref});
+    PTRef a = logic.mkVar(sref, "a");
+    PTRef b = logic.mkVar(sref, "b");
+    vec<PTRef> garbage;
+    for (int i = 0; i < 1000; i++) {
+        PTRef c = logic.mkVar(sref, ("c" + std::to_string(i)).c_str());
+        garbage.push(logic.mkEq(logic.mkUninterpFun(f, {a, c}), b));
+    }
+    PTRef fab = logic.mkUninterpFun(f, {a, b});
+    PTRef root = logic.mkOr(logic.mkEq(fab, a), logic.mkBoolVar("p"));
+    std::string rootStr = logic.printTerm(root);
+
+    vec<PTRef> roots;
+    roots.push(root);
+    auto stats = logic.collectGarbage(roots);
+    EXPECT_GE(stats.collectedTerms, 3000u);
+    EXPECT_GT(stats.reclaimedBytes, 0u);
+    root = roots[0];
+    EXPECT_EQ(logic.printTerm(root), rootStr);
+
+    // Surviving terms are still hash-consed, collected terms can be created again
+    PTRef a2 = logic.mkVar(sref, "a");
+    PTRef b2 = logic.mkVar(sref, "b");
+    PTRef fab2 = logic.mkUninterpFun(f, {a2, b2});
+    EXPECT_EQ(logic.mkOr(logic.mkEq(fab2, a2), logic.mkBoolVar("p")), root);
+    PTRef c0 = logic.mkVar(sref, "c0");
+    PTRef eq = logic.mkEq(logic.mkUninterpFun(f, {a2, c0}), b2);
+    EXPECT_TRUE(logic.isEquality(eq));
+    EXPECT_NE(eq, root);
+    EXPECT_TRUE(logic.isTrue(logic.getTerm_true()));
+}
+
 bool contains(vec<PTRef> const& v, PTRef t) {
     for (PTRef e : v) {
         if (t == e) {
@@ -80,4 +80,37 @@ TEST(Polynomial_test, test_Merge3){
     EXPECT_EQ(removed[0], x2);
     ASSERT_TRUE(poly1.contains(x1));
     ASSERT_TRUE(!poly1.contains(x2));
-}
\ No newline at end of file
+}
+TEST(Polynomial_test, test_MergeKeepsOrder){
+    // (x1 + 2x3 - x5 + x7) + 2 * (x0 - x3 + x4 + x6 + x8) with cancellation of x3 in the middle
+    Polynomial poly1;
+    Polynomial poly2;
+    std::vector<LVRef> x;
+    for (unsigned i = 0; i < 9; ++i) { x.push_back(LVRef{i}); }
+    poly1.addTerm(x[1], 1);
+    poly1.addTerm(x[3], 2);
+    poly1.addTerm(x[5], -1);
+    poly1.addTerm(x[7], 1);
+    poly2.addTerm(x[8], 1);
+    poly2.addTerm(x[0], 1);
+    poly2.addTerm(x[6], 1);
+    poly2.addTerm(x[4], 1);
+    poly2.addTerm(x[3], -1);
+    std::vector<LVRef> added;
+    std::vector<LVRef> removed;
+    auto add = [&added](LVRef v) { added.push_back(v); };
+    auto remove = [&removed](LVRef v) { removed.push_back(v); };
+    poly1.merge(poly2, 2, add, remove);
+    EXPECT_EQ(added.size(), 4);
+    ASSERT_EQ(removed.size(), 1);
+    EXPECT_EQ(removed[0], x[3]);
+    ASSERT_EQ(poly1.size(), 7);
+    std::vector<unsigned> ids;
+    for (auto const & term : poly1) {
+        ids.push_back(term.var.x);
+    }
+    EXPECT_EQ(ids, std::vector<unsigned>({0, 1, 4, 5, 6, 7, 8}));
+    EXPECT_EQ(poly1.getCoeff(x[0]), 2);
+    EXPECT_EQ(poly1.getCoeff(x[5]), -1);
+    EXPECT_EQ(poly1.getCoeff(x[8]), 2);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <gtest/gtest.h>
+#include <ClauseExchange.h>
+#include <Logic.h>
+#include <MainSolver.h>
+#include <SMTConfig.h>
+
+#include <string>
+#include <vector>
+
+TEST(ClauseExchangeTest, test_BroadcastToOthers) {
+    ClauseExchange exchange(3, 16);
+    vec<Lit> c{mkLit(1), mkLit(2, true)};
+    ASSERT_TRUE(exchange.publish(0, c));
+
+    vec<Lit> out;
+    ASSERT_EQ(exchange.collect(0, out), 0);
+    ASSERT_EQ(exchange.collect(1, out), 1);
+    ASSERT_EQ(out.size(), 3);
+    ASSERT_EQ(out[0], mkLit(1));
+    ASSERT_EQ(out[1], mkLit(2, true));
+    ASSERT_EQ(out[2], lit_Undef);
+
+    out.clear();
+    ASSERT_EQ(exchange.collect(1, out), 0); // Already seen
+    ASSERT_EQ(exchange.collect(2, out), 1);
+}
+
+TEST(ClauseExchangeTest, test_LongClausesAreNotShared) {
+    ClauseExchange exchange(2, 16);
+    vec<Lit> c;
+    for (int i = 0; i <= ClauseExchange::maxClauseSize; i++)
+        c.push(mkLit(i));
+    ASSERT_FALSE(exchange.publish(0, c));
+    vec<Lit> out;
+    ASSERT_EQ(exchange.collect(1, out), 0);
+}
+
+TEST(ClauseExchangeTest, test_LappedConsumerKeepsNewest) {
+    ClauseExchange exchange(2, 4);
+    for (int i = 0; i < 10; i++) {
+        vec<Lit> c{mkLit(i)};
+        exchange.publish(1, c);
+    }
+    vec<Lit> out;
+    ASSERT_EQ(exchange.collect(0, out), 4);
+    ASSERT_EQ(out[0], mkLit(6));
+    ASSERT_EQ(out[6], mkLit(9));
+}
+
+class PortfolioTest : public ::testing::Test {
+protected:
+    PortfolioTest() : logic{opensmt::Logic_t::QF_UF} {
+        const char* msg;
+        config.setOption(SMTConfig::o_threads, SMTOption(4), msg);
+    }
+    SMTConfig config;
+    Logic logic;
+
+    // n+1 pigeons do not fit in n holes
+    PTRef pigeonHole(int n) {
+        std::vector<std::vector<PTRef>> p(n + 1);
+        for (int i = 0; i <= n; i++) {
+            for (int j = 0; j < n; j++)
+                p[i].push_back(logic.mkBoolVar(("p_" + std::to_string(i) + "_" + std::to_string(j)).c_str()));
+        }
+        vec<PTRef> constraints;
+        for (int i = 0; i <= n; i++) {
+            vec<PTRef> holes;
+            for (PTRef tr : p[i])
+                holes.push(tr);
+            constraints.push(logic.mkOr(std::move(holes)));
+        }
+        for (int j = 0; j < n; j++)
+            for (int i = 0; i <= n; i++)
+                for (int k = i + 1; k <= n; k++)
+                    constraints.push(logic.mkOr(logic.mkNot(p[i][j]), logic.mkNot(p[k][j])));
+        return logic.mkAnd(std::move(constraints));
+    }
+};
+
+TEST_F(PortfolioTest, test_InvalidThreadCount) {
+    const char* msg;
+    ASSERT_FALSE(config.setOption(SMTConfig::o_threads, SMTOption(0), msg));
+    ASSERT_EQ(config.threads(), 4);
+}
+
+TEST_F(PortfolioTest, test_Unsat) {
+    MainSolver solver(logic, config, "portfolio");
+    solver.insertFormula(pigeonHole(6));
+    ASSERT_EQ(solver.check(), s_False);
+}
+
+TEST_F(PortfolioTest, test_SatWithModel) {
+    config.setProduceModels();
+    SRef U = logic.declareUninterpretedSort("U");
+    PTRef x = logic.mkVar(U, "x");
+    PTRef y = logic.mkVar(U, "y");
+    SymRef f_sym = logic.declareFun("f", U, {U});
+    PTRef fx = logic.mkUninterpFun(f_sym, {x});
+    PTRef fy = logic.mkUninterpFun(f_sym, {y});
+    PTRef a = logic.mkBoolVar("a");
+
+    MainSolver solver(logic, config, "portfolio");
+    solver.insertFormula(logic.mkOr(a, logic.mkEq(x, y)));
+    solver.insertFormula(logic.mkOr(logic.mkNot(a), logic.mkNot(logic.mkEq(fx, fy))));
+    ASSERT_EQ(solver.check(), s_True);
+    auto model = solver.getModel();
+    bool aVal = model->evaluate(a) == logic.getTerm_true();
+    bool xyEq = model->evaluate(x) == model->evaluate(y);
+    bool fEq = model->evaluate(fx) == model->evaluate(fy);
+    ASSERT_TRUE(aVal or xyEq);
+    ASSERT_TRUE(not aVal or not fEq);
+}
+
+TEST_F(PortfolioTest, test_Incremental) {
+    MainSolver solver(logic, config, "portfolio");
+    PTRef a = logic.mkBoolVar("a");
+    PTRef b = logic.mkBoolVar("b");
+    solver.insertFormula(logic.mkOr(a, b));
+    ASSERT_EQ(solver.check(), s_True);
+    solver.push();
+    solver.insertFormula(pigeonHole(5));
+    ASSERT_EQ(solver.check(), s_False);
+    solver.pop();
+    ASSERT_EQ(solver.check(), s_True);
+    solver.push();
+    solver.insertFormula(logic.mkNot(a));
+    solver.insertFormula(logic.mkNot(b));
+    ASSERT_EQ(solver.check(), s_False);
+    solver.pop();
+    ASSERT_EQ(solver.check(), s_True);
+}
@@ -492,3 +492,22 @@ TEST(Rationals_test, testWordRepresentation_Inverse) {
     ASSERT_TRUE(a.wordPartValid());
 }
 
+
+TEST(Rationals_test, test_multiplyAddAssign) {
+    uword uintMax = UINT_MAX;
+    std::vector<FastRational> values {
+        0, 1, -1, 3, FastRational(2, 3), FastRational(-5, 7), FastRational(1, uintMax), FastRational(INT_MAX, 2),
+        INT_MAX, INT_MIN, FastRational("123456789012345678901234567890"), FastRational("-1/98765432109876543210")
+    };
+    for (auto const & a : values) {
+        for (auto const & b : values) {
+            for (auto const & c : values) {
+                FastRational res = a;
+                multiplyAddAssign(res, b, c);
+                ASSERT_EQ(res, a + b * c);
+                ASSERT_TRUE(res.isWellFormed());
+                ASSERT_EQ(res.wordPartValid(), (a + b * c).wordPartValid());
+            }
+        }
+    }
+}
@@ -157,3 +157,73 @@ TEST(Simplex_test, test_Assignment)
     EXPECT_GE(x_val, -5);
     EXPECT_EQ(x_val, -1 * y_val);
 }
+
+TEST(Simplex_test, test_DevexPivoting)
+{
+    // x + y >= 4, x - y >= 0, x + 2y <= 7, x <= 3 is satisfiable; adding y >= 3 makes it unsatisfiable
+    for (unsigned blandThreshold : {0u, 1u}) {
+        LAVarStore vs;
+        LVRef x = vs.getNewVar();
+        LVRef y = vs.getNewVar();
+        LVRef x_plus_y = vs.getNewVar();
+        LVRef x_minus_y = vs.getNewVar();
+        LVRef x_plus_2y = vs.getNewVar();
+
+        LABoundStore bs(vs);
+        LABoundStore::BoundInfo x_nostrict_3 = bs.allocBoundPair(x, { Delta(3), Delta(3, 1) }); // x <= 3 and x > 3
+        LABoundStore::BoundInfo y_strict_3 = bs.allocBoundPair(y, { Delta(3, -1), Delta(3) }); // y < 3 and y >= 3
+        LABoundStore::BoundInfo sum_strict_4 = bs.allocBoundPair(x_plus_y, { Delta(4, -1), Delta(4) }); // x + y < 4 and x + y >= 4
+        LABoundStore::BoundInfo diff_strict_0 = bs.allocBoundPair(x_minus_y, { Delta(0, -1), Delta(0) }); // x - y < 0 and x - y >= 0
+        LABoundStore::BoundInfo sum2_nostrict_7 = bs.allocBoundPair(x_plus_2y, { Delta(7), Delta(7, 1) }); // x + 2y <= 7 and x + 2y > 7
+        bs.buildBounds();
+
+        Simplex s(bs);
+        s.setPivotingRule(Simplex::PivotingRule::Devex, blandThreshold);
+        s.newNonbasicVar(x);
+        s.newNonbasicVar(y);
+        auto p_x_plus_y = std::make_unique<Polynomial>();
+        p_x_plus_y->addTerm(x, 1);
+        p_x_plus_y->addTerm(y, 1);
+        s.newRow(x_plus_y, std::move(p_x_plus_y));
+        auto p_x_minus_y = std::make_unique<Polynomial>();
+        p_x_minus_y->addTerm(x, 1);
+        p_x_minus_y->addTerm(y, -1);
+        s.newRow(x_minus_y, std::move(p_x_minus_y));
+        auto p_x_plus_2y = std::make_unique<Polynomial>();
+        p_x_plus_2y->addTerm(x, 1);
+        p_x_plus_2y->addTerm(y, 2);
+        s.newRow(x_plus_2y, std::move(p_x_plus_2y));
+        s.initModel();
+
+        s.assertBoundOnVar(x, x_nostrict_3.ub);
+        s.assertBoundOnVar(x_plus_y, sum_strict_4.lb);
+        s.assertBoundOnVar(x_minus_y, diff_strict_0.lb);
+        s.assertBoundOnVar(x_plus_2y, sum2_nostrict_7.ub);
+        ASSERT_EQ(s.checkSimplex().size(), 0);
+        EXPECT_GE(s.getValuation(x_plus_y), Delta(4));
+        EXPECT_GE(s.getValuation(x_minus_y), Delta(0));
+        EXPECT_LE(s.getValuation(x_plus_2y), Delta(7));
+        EXPECT_LE(s.getValuation(x), Delta(3));
+        EXPECT_EQ(s.getValuation(x_plus_y), s.getValuation(x) + s.getValuation(y));
+
+        s.pushBacktrackPoint();
+        s.assertBoundOnVar(y, y_strict_3.lb);
+        EXPECT_GT(s.checkSimplex().size(), 0);
+        s.popBacktrackPoint();
+        s.finalizeBacktracking();
+        ASSERT_EQ(s.checkSimplex().size(), 0);
+    }
+}
+
+TEST(Simplex_test, test_PivotingOptions)
+{
+    SMTConfig c;
+    const char* msg;
+    EXPECT_FALSE(c.lra_devex_pivoting());
+    EXPECT_TRUE(c.setOption(SMTConfig::o_lra_pivoting_rule, SMTOption(lrapivs_devex), msg));
+    EXPECT_TRUE(c.lra_devex_pivoting());
+    EXPECT_FALSE(c.setOption(SMTConfig::o_lra_pivoting_rule, SMTOption("steepest"), msg));
+    EXPECT_TRUE(c.setOption(SMTConfig::o_lra_bland_threshold, SMTOption(100), msg));
+    EXPECT_EQ(c.lra_bland_threshold(), 100);
+    EXPECT_FALSE(c.setOption(SMTConfig::o_lra_bland_threshold, SMTOption(-1), msg));
+}
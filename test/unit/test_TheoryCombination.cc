@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2022, Antti Hyvarinen <antti.hyvarinen@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <gtest/gtest.h>
+#include <ArithLogic.h>
+#include <MainSolver.h>
+#include <SMTConfig.h>
+
+#include <string>
+#include <vector>
+
+class TheoryCombinationTest : public ::testing::TestWithParam<const char*> {
+protected:
+    TheoryCombinationTest() {
+        const char* msg;
+        config.setOption(SMTConfig::o_uf_la_combination, SMTOption(GetParam()), msg);
+        config.setProduceModels();
+    }
+    SMTConfig config;
+};
+
+TEST(TheoryCombinationOptionTest, test_UnknownCombination) {
+    SMTConfig config;
+    const char* msg;
+    ASSERT_FALSE(config.setOption(SMTConfig::o_uf_la_combination, SMTOption("lazy"), msg));
+    ASSERT_FALSE(config.uf_la_eager_combination());
+    ASSERT_TRUE(config.setOption(SMTConfig::o_uf_la_combination, SMTOption("eager"), msg));
+    ASSERT_TRUE(config.uf_la_eager_combination());
+}
+
+TEST_P(TheoryCombinationTest, test_EqualityFromArithmetic) {
+    ArithLogic logic{opensmt::Logic_t::QF_UFLRA};
+    PTRef x = logic.mkRealVar("x");
+    PTRef y = logic.mkRealVar("y");
+    SymRef f = logic.declareFun("f", logic.getSort_real(), {logic.getSort_real()});
+    MainSolver solver(logic, config, "combination");
+    solver.insertFormula(logic.mkLeq(x, y));
+    solver.insertFormula(logic.mkLeq(y, x));
+    solver.insertFormula(logic.mkNot(logic.mkEq(logic.mkUninterpFun(f, {x}), logic.mkUninterpFun(f, {y}))));
+    ASSERT_EQ(solver.check(), s_False);
+}
+
+TEST_P(TheoryCombinationTest, test_EqualityFromCongruence) {
+    ArithLogic logic{opensmt::Logic_t::QF_UFLRA};
+    PTRef x = logic.mkRealVar("x");
+    PTRef y = logic.mkRealVar("y");
+    SymRef f = logic.declareFun("f", logic.getSort_real(), {logic.getSort_real()});
+    PTRef fx = logic.mkUninterpFun(f, {x});
+    PTRef fy = logic.mkUninterpFun(f, {y});
+    MainSolver solver(logic, config, "combination");
+    solver.insertFormula(logic.mkEq(x, y));
+    solver.insertFormula(logic.mkLt(logic.mkPlus(fx, logic.mkRealConst(1)), fy));
+    ASSERT_EQ(solver.check(), s_False);
+}
+
+TEST_P(TheoryCombinationTest, test_ModelSeparatesClasses) {
+    ArithLogic logic{opensmt::Logic_t::QF_UFLRA};
+    SymRef f = logic.declareFun("f", logic.getSort_real(), {logic.getSort_real()});
+    std::vector<PTRef> x;
+    vec<PTRef> fx;
+    for (int i = 0; i < 5; i++) {
+        x.push_back(logic.mkRealVar(("x_" + std::to_string(i)).c_str()));
+        fx.push(logic.mkUninterpFun(f, {x.back()}));
+    }
+    MainSolver solver(logic, config, "combination");
+    for (PTRef var : x) {
+        solver.insertFormula(logic.mkLeq(logic.getTerm_RealZero(), var));
+        solver.insertFormula(logic.mkLeq(var, logic.mkRealConst(1)));
+    }
+    solver.insertFormula(logic.mkDistinct(std::move(fx)));
+    ASSERT_EQ(solver.check(), s_True);
+    auto model = solver.getModel();
+    for (std::size_t i = 0; i < x.size(); i++) {
+        for (std::size_t j = 0; j < i; j++)
+            ASSERT_NE(model->evaluate(x[i]), model->evaluate(x[j]));
+    }
+}
+
+TEST_P(TheoryCombinationTest, test_IntegerEqualities) {
+    ArithLogic logic{opensmt::Logic_t::QF_UFLIA};
+    PTRef x = logic.mkIntVar("x");
+    PTRef zero = logic.getTerm_IntZero();
+    PTRef one = logic.getTerm_IntOne();
+    SymRef f = logic.declareFun("f", logic.getSort_int(), {logic.getSort_int()});
+    PTRef fx = logic.mkUninterpFun(f, {x});
+    MainSolver solver(logic, config, "combination");
+    solver.insertFormula(logic.mkLeq(zero, x));
+    solver.insertFormula(logic.mkLeq(x, one));
+    solver.insertFormula(logic.mkNot(logic.mkEq(fx, logic.mkUninterpFun(f, {zero}))));
+    solver.push();
+    solver.insertFormula(logic.mkNot(logic.mkEq(fx, logic.mkUninterpFun(f, {one}))));
+    ASSERT_EQ(solver.check(), s_False);
+    solver.pop();
+    ASSERT_EQ(solver.check(), s_True);
+    auto model = solver.getModel();
+    ASSERT_EQ(model->evaluate(x), one);
+}
+
+TEST_P(TheoryCombinationTest, test_InterfaceVariablesFromDifferentFrames) {
+    ArithLogic logic{opensmt::Logic_t::QF_UFLRA};
+    PTRef x = logic.mkRealVar("x");
+    PTRef y = logic.mkRealVar("y");
+    SymRef f = logic.declareFun("f", logic.getSort_real(), {logic.getSort_real()});
+    MainSolver solver(logic, config, "combination");
+    solver.insertFormula(logic.mkEq(logic.mkUninterpFun(f, {x}), logic.getTerm_RealZero()));
+    ASSERT_EQ(solver.check(), s_True);
+    solver.push();
+    solver.insertFormula(logic.mkEq(logic.mkUninterpFun(f, {y}), logic.getTerm_RealOne()));
+    solver.insertFormula(logic.mkEq(logic.mkPlus(x, y), logic.mkTimes(logic.mkRealConst(2), x)));
+    ASSERT_EQ(solver.check(), s_False);
+    solver.pop();
+    ASSERT_EQ(solver.check(), s_True);
+}
+
+INSTANTIATE_TEST_SUITE_P(Combination, TheoryCombinationTest, ::testing::Values("model", "eager"));